@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file arena.h
+ * @brief Bump pointer arena for scratch memory
+ *
+ * An arena hands out memory by advancing an offset through one region.
+ * Nothing is freed individually: a mark records the offset and resetting
+ * to it releases everything allocated since, in one step.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ARENA_DEFAULT_ALIGN (16)  /* Alignment used when 0 is requested */
+
+/**
+ * @brief Arena bookkeeping, stored at the start of its own region.
+ */
+typedef struct {
+  uint8_t * base;   /* First usable byte */
+  size_t size;      /* Usable bytes from base */
+  size_t used;      /* Bytes handed out so far */
+  uint8_t backing;  /* How the region was obtained, see arena.c */
+} arena_t;
+
+/**
+ * @brief Offset into an arena returned by arena_mark().
+ */
+typedef size_t arena_mark_t;
+
+/**
+ * @brief Creates an arena with its own backing region.
+ *
+ * The host maps anonymous memory, which the kernel only commits on first
+ * touch. The MSP432 takes the region from the linker heap through the C
+ * library.
+ *
+ * @param size Usable bytes in the arena.
+ *
+ * @return Pointer to the arena, or a Null Pointer if out of memory.
+ */
+arena_t * arena_create(size_t size);
+
+/**
+ * @brief Creates an arena inside caller provided memory.
+ *
+ * Useful for a static buffer on the MSP432. The bookkeeping is taken from
+ * the start of the buffer. arena_destroy() leaves the buffer untouched.
+ *
+ * @param buffer Pointer to the memory to manage.
+ * @param size Length of bytes of the buffer.
+ *
+ * @return Pointer to the arena, or a Null Pointer if the buffer is too small.
+ */
+arena_t * arena_init(void * buffer, size_t size);
+
+/**
+ * @brief Allocates aligned memory from an arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param size Number of bytes requested.
+ * @param alignment Power of two alignment, or 0 for ARENA_DEFAULT_ALIGN.
+ *
+ * @return Pointer to the memory, or a Null Pointer if the arena is full or
+ *         the alignment is not a power of two.
+ */
+void * arena_alloc(arena_t * arena, size_t size, size_t alignment);
+
+/**
+ * @brief Records the current fill level of an arena.
+ *
+ * @param arena Pointer to the arena.
+ *
+ * @return Mark to pass to arena_reset().
+ */
+arena_mark_t arena_mark(arena_t * arena);
+
+/**
+ * @brief Releases everything allocated since a mark.
+ *
+ * A mark of 0 empties the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param mark Value returned by arena_mark().
+ *
+ * @return void.
+ */
+void arena_reset(arena_t * arena, arena_mark_t mark);
+
+/**
+ * @brief Destroys an arena and releases its backing region.
+ *
+ * @param arena Pointer to the arena, a Null Pointer is ignored.
+ *
+ * @return void.
+ */
+void arena_destroy(arena_t * arena);
+
+#endif /* __ARENA_H__ */
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file bench.h
+ * @brief Throughput benchmarks for the memory primitives.
+ *
+ * Host only benchmark driver built by the "bench" Makefile target. Results
+ * are printed as CSV so they can be pasted straight into a spreadsheet.
+ * Building with BENCH_JSON prints only the sweeps, as JSON Lines.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform.h"
+#include "memory.h"
+#include "checksum.h"
+#include "dma.h"
+#include "mpmc.h"
+#include "stats.h"
+
+/* Largest buffer swept by the scaling benchmark. Override with
+   -DBENCH_MAX_SIZE=<bytes> on machines with little memory. */
+#ifndef BENCH_MAX_SIZE
+#define BENCH_MAX_SIZE       ((size_t)1 << 30)
+#endif
+
+#define BENCH_TARGET_BYTES   ((size_t)1 << 28) /* Bytes processed per data point */
+#define BENCH_MAX_ITERATIONS ((size_t)1 << 20) /* Cap on calls per data point */
+#define BENCH_STREAM_MIN_SIZE ((size_t)1 << 16) /* Smallest streamed buffer */
+#define BENCH_PREFETCH_MIN_SIZE ((size_t)1 << 18) /* Smallest prefetched buffer */
+#define BENCH_SWEEP_SIZE     ((size_t)4096)    /* Length of the alignment and overlap sweeps */
+#define BENCH_SWEEP_ALIGN    (64)              /* Slack for misaligning the sweep buffers */
+#define BENCH_MAX_THREADS    (32)              /* Largest thread count swept */
+#define BENCH_BATCH_COUNT    (1024)            /* Fragments per batched copy */
+#define BENCH_DMA_BLOCK      ((size_t)1 << 20) /* Bytes per staged DMA buffer */
+#define BENCH_MPMC_THREADS   (64)              /* Largest queue thread count swept */
+#define BENCH_MPMC_ITEMS     ((size_t)1 << 20) /* Pointers passed per data point */
+#define BENCH_MPMC_CAPACITY  (1024)            /* Slots in the benchmarked queue */
+
+/**
+ * @brief Runs every benchmark.
+ *
+ * @return void.
+ */
+void bench(void);
+
+/**
+ * @brief Sweeps each primitive and its libc equivalent over sizes.
+ *
+ * my_memcopy, my_memmove, my_memset, my_memzero and my_reverse are timed
+ * against memcpy, memmove and memset from 1 byte to BENCH_MAX_SIZE on
+ * aligned buffers. Each record gives the throughput and the time per call.
+ * my_reverse has no libc equivalent.
+ *
+ * @return void.
+ */
+void bench_sizes(void);
+
+/**
+ * @brief Sweeps each primitive and its libc equivalent over alignments.
+ *
+ * BENCH_SWEEP_SIZE byte operations are timed for source and destination
+ * offsets from 0 to 63 bytes past a cache line boundary.
+ *
+ * @return void.
+ */
+void bench_alignment(void);
+
+/**
+ * @brief Sweeps my_memmove and memmove over overlap distances.
+ *
+ * BENCH_SWEEP_SIZE byte moves are timed with the destination from a whole
+ * length below to a whole length above the source, including the nearly
+ * complete overlaps of a few bytes.
+ *
+ * @return void.
+ */
+void bench_overlap(void);
+
+/**
+ * @brief Sweeps the primitives from 1 byte to BENCH_MAX_SIZE.
+ *
+ * Each memory.h primitive is timed over buffer sizes growing in powers of
+ * two and the throughput is printed in GB/s, one row per size.
+ *
+ * @return void.
+ */
+void bench_scaling(void);
+
+/**
+ * @brief Compares cached and non-temporal copies and fills.
+ *
+ * Times my_memcopy_stream() and my_memset_stream() with MEM_STREAM_NEVER
+ * and MEM_STREAM_ALWAYS from 64 KiB to BENCH_MAX_SIZE, showing where the
+ * streaming stores start to pay off.
+ *
+ * @return void.
+ */
+void bench_stream(void);
+
+/**
+ * @brief Measures the parallel copy and fill against thread count.
+ *
+ * Times my_memcopy_parallel() and my_memset_parallel() with 1 to
+ * BENCH_MAX_THREADS threads for buffers from MEM_PARALLEL_CUTOFF up to
+ * BENCH_MAX_SIZE.
+ *
+ * @return void.
+ */
+void bench_parallel(void);
+
+/**
+ * @brief Compares my_memcmp() and my_memchr() against the C library.
+ *
+ * Times both primitives and their libc counterparts over equal buffers
+ * with no match, so every call scans the whole length, from 1 byte to
+ * BENCH_MAX_SIZE.
+ *
+ * @return void.
+ */
+void bench_compare(void);
+
+/**
+ * @brief Measures my_reverse_elements() and my_byteswap().
+ *
+ * Times reversing the element order in place and byte swapping between
+ * two buffers for 2, 4 and 8 byte elements, from 16 bytes to
+ * BENCH_MAX_SIZE.
+ *
+ * @return void.
+ */
+void bench_elements(void);
+
+/**
+ * @brief Compares my_memcopy_batch() with one my_memcopy() per fragment.
+ *
+ * BENCH_BATCH_COUNT fragments scattered over a buffer larger than the
+ * caches are gathered into one run, for fragment sizes from 1 to 1024
+ * bytes.
+ *
+ * @return void.
+ */
+void bench_batch(void);
+
+/**
+ * @brief Compares a copy followed by a CRC32C pass with the fused copy.
+ *
+ * Times crc32c() alone, my_memcopy() then crc32c(), and crc32c_copy()
+ * from 64 KiB to BENCH_MAX_SIZE.
+ *
+ * @return void.
+ */
+void bench_crc32c(void);
+
+/**
+ * @brief Measures overlapping transfers with computation through the engine.
+ *
+ * Stages BENCH_MAX_SIZE bytes through two BENCH_DMA_BLOCK buffers and runs
+ * find_mean() and find_maximum() on each block, first copying and computing
+ * in turn, then with the next block's copy submitted to a dma engine while
+ * the current block is computed on.
+ *
+ * @return void.
+ */
+void bench_dma(void);
+
+/**
+ * @brief Compares software prefetching with the hardware prefetcher alone.
+ *
+ * Calibrates the prefetch distance, then times the cached copy, my_memchr()
+ * and find_mean() with prefetching off and at the calibrated distance,
+ * from 256 KiB to BENCH_MAX_SIZE.
+ *
+ * @return void.
+ */
+void bench_prefetch(void);
+
+/**
+ * @brief Measures the throughput of the multi producer, multi consumer queue.
+ *
+ * Passes BENCH_MPMC_ITEMS pointers through one queue with 1 to
+ * BENCH_MPMC_THREADS threads, doubling each step. One thread pushes and
+ * pops in turn; more are split evenly into producers and consumers.
+ *
+ * @return void.
+ */
+void bench_mpmc(void);
+
+#endif /* __BENCH_H__ */
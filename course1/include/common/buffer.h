@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file buffer.h
+ * @brief Reference counted buffers with zero copy views
+ *
+ * A buffer is one block from the word allocator shared by any number of
+ * views. A view names a byte range of a buffer and holds one reference to
+ * it, so handing a view to the next stage of a pipeline passes ownership
+ * without copying bytes. Slicing narrows the range and sharing adds a
+ * reference; the buffer is freed when its last view is released. Writing
+ * through a view first copies its range into a private buffer whenever
+ * other views still share the bytes.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __BUFFER_H__
+#define __BUFFER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUFFER_ALIGN (16)  /* Alignment of the first byte of every buffer */
+
+/**
+ * @brief Shared storage behind a view, defined in buffer.c.
+ */
+typedef struct buffer buffer_t;
+
+/**
+ * @brief Byte range of a buffer holding one reference to it.
+ *
+ * Views are small and passed by value. A view with a Null buffer is empty
+ * and every function accepts it.
+ */
+typedef struct {
+  buffer_t * buffer;  /* Shared storage, or a Null Pointer when empty */
+  size_t offset;      /* First byte of the range within the buffer */
+  size_t length;      /* Length of bytes of the range */
+} buffer_view_t;
+
+/**
+ * @brief Creates a buffer and returns a view of all of it.
+ *
+ * The contents are left uninitialised.
+ *
+ * @param length Length of bytes of the buffer.
+ *
+ * @return View of the buffer, or an empty view if length is 0 or out of
+ *         memory.
+ */
+buffer_view_t buffer_create(size_t length);
+
+/**
+ * @brief Creates a buffer holding a copy of existing bytes.
+ *
+ * @param src Pointer to the bytes to copy.
+ * @param length Length of bytes to copy.
+ *
+ * @return View of the buffer, or an empty view if length is 0 or out of
+ *         memory.
+ */
+buffer_view_t buffer_from(const uint8_t * src, size_t length);
+
+/**
+ * @brief Adds a reference to the buffer of a view.
+ *
+ * @param view View to share.
+ *
+ * @return A second view of the same range, to be released separately.
+ */
+buffer_view_t buffer_share(buffer_view_t view);
+
+/**
+ * @brief Adds a reference to part of the range of a view.
+ *
+ * @param view View to slice.
+ * @param offset First byte of the slice, relative to the view.
+ * @param length Length of bytes of the slice.
+ *
+ * @return View of the sub-range, to be released separately, or an empty
+ *         view if the sub-range does not lie within the view.
+ */
+buffer_view_t buffer_slice(buffer_view_t view, size_t offset, size_t length);
+
+/**
+ * @brief Drops the reference a view holds and empties it.
+ *
+ * The buffer is returned to the word allocator with its last reference.
+ *
+ * @param view Pointer to the view to release.
+ *
+ * @return void
+ */
+void buffer_release(buffer_view_t * view);
+
+/**
+ * @brief Returns the bytes of a view for reading.
+ *
+ * @param view View to read.
+ *
+ * @return Pointer to the first byte, or a Null Pointer for an empty view.
+ */
+const uint8_t * buffer_data(buffer_view_t view);
+
+/**
+ * @brief Returns the bytes of a view for writing.
+ *
+ * When other views share the buffer, the range is first copied into a new
+ * buffer that the view then refers to alone, so the other views keep
+ * seeing the old bytes. A view that already holds the only reference is
+ * written in place.
+ *
+ * @param view Pointer to the view to write.
+ *
+ * @return Pointer to the first byte, or a Null Pointer for an empty view or
+ *         if the copy could not be allocated. The view is unchanged then.
+ */
+uint8_t * buffer_mutable(buffer_view_t * view);
+
+/**
+ * @brief Returns the number of views referring to the buffer of a view.
+ *
+ * @param view View to query.
+ *
+ * @return Reference count, or 0 for an empty view.
+ */
+uint32_t buffer_refs(buffer_view_t view);
+
+#endif /* __BUFFER_H__ */
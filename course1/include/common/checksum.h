@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file checksum.h
+ * @brief CRC32C checksums, standalone and fused with a copy
+ *
+ * CRC32C (Castagnoli, the polynomial of iSCSI, ext4 and SSE4.2) over a
+ * buffer, or over a buffer while it is copied so received data can be
+ * moved and validated in a single pass.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __CHECKSUM_H__
+#define __CHECKSUM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define CRC32C_POLY  (0x82F63B78u)  /* Reflected Castagnoli polynomial */
+#define CRC32C_CHECK (0xE3069283u)  /* crc32c() of the ASCII "123456789" */
+
+/**
+ * @brief Computes the CRC32C of a buffer.
+ *
+ * Given pointer to source memory location, this returns the CRC32C of
+ * its bytes. The result of one call can be passed back in as crc to
+ * continue the checksum over the next buffer.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param crc 0 to start a checksum, or the result over preceding bytes.
+ *
+ * @return CRC32C of the bytes seen so far.
+ */
+uint32_t crc32c(const uint8_t * src, size_t length, uint32_t crc);
+
+/**
+ * @brief Copies bytes and computes their CRC32C in the same pass.
+ *
+ * Given two pointers to a char data set, this will copy bytes from the
+ * source to the destination like my_memcopy() while computing the CRC32C
+ * of the bytes copied, so the data is only read once. The regions must
+ * not overlap.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy from the source to the destination.
+ * @param crc 0 to start a checksum, or the result over preceding bytes.
+ *
+ * @return CRC32C of the bytes seen so far.
+ */
+uint32_t crc32c_copy(const uint8_t * src, uint8_t * dst, size_t length,
+                     uint32_t crc);
+
+/**
+ * @brief Names the implementation used by the CRC32C functions.
+ *
+ * @return "sse4.2" when the CRC32 instruction is used, else "slice8".
+ */
+const char * crc32c_isa(void);
+
+#endif /* __CHECKSUM_H__ */
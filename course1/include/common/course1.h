@@ -24,16 +24,52 @@
 #include "memory.h"
 #include "stats.h"
 #include "data.h"
+#include "arena.h"
+#include "memstats.h"
+#include "pool.h"
+#include "checksum.h"
+#include "dma.h"
+#include "buffer.h"
+#include "ring.h"
+#include "mpmc.h"
 
 #define DATA_SET_SIZE_W (10)
 #define MEM_SET_SIZE_B  (32)
 #define MEM_SET_SIZE_W  (8)
 #define MEM_ZERO_LENGTH (16)
+#define MEM_LARGE_SIZE_B (4096)
+#define MEM_LARGE_SIZE_W (1024)
+#define ARENA_SIZE_B     (4096)
+#define MEM_BATCH_COUNT  (32)
+#define MEM_VALUES_LENGTH (10)
+#define MEM_FIXED_SIZE_B (256)
+#define MEM_FIXED_SIZE_W (64)
+#define RING_CAPACITY    (13)
+#define MPMC_CAPACITY    (5)
+#define MEM_STREAM_ALIGN (64)
+#define MEM_PARALLEL_SIZE_B (MEM_PARALLEL_CUTOFF + 13)
+#define MEM_PARALLEL_SIZE_W ((MEM_PARALLEL_SIZE_B / 4) + 1)
+#define POOL_TEST_THREADS (8)
+#define POOL_TEST_BLOCKS  (40)
+#define POOL_TEST_SIZE    (1000)
+#define POOL_HUGE_TEST_THRESHOLD ((size_t)64 << 10)
+#define POOL_HUGE_TEST_SIZE ((size_t)(100 << 10) + 3)
+#define RING_THREAD_CAPACITY (16)
+#define RING_THREAD_CHUNK    (23)
+#define RING_THREAD_BYTES    ((size_t)1 << 18)
+#define MPMC_THREAD_PAIRS (2)
+#define MPMC_THREAD_ITEMS ((size_t)1 << 15)
+#define MEM_ALIGN_TEST_OFFSETS (8)
+#define MEM_ALIGN_TEST_STREAM (4096)
+#define MEM_ALIGN_TEST_SIZE_B (MEM_ALIGN_TEST_STREAM + 192)
+#define MEM_ALIGN_TEST_SIZE_W (MEM_ALIGN_TEST_SIZE_B / 4)
+#define MEM_GUARD_TEST_LENGTHS (5)
+#define MEM_GUARD_TEST_REDZONE (80)
 
 #define TEST_MEMMOVE_LENGTH (16)
 #define TEST_ERROR          (1)
 #define TEST_NO_ERROR       (0)
-#define TESTCOUNT           (8)
+#define TESTCOUNT           (34)
 
 #define BASE_16             (16)
 #define BASE_10             (10)
@@ -134,5 +170,308 @@ int8_t test_memset();
  */
 int8_t test_reverse();
 
+/**
+ * @brief function to test the memory functions past 255 bytes
+ * 
+ * This function calls the copy, move, set and reverse routines with lengths
+ * that do not fit in a byte, at unaligned offsets, to validate that the
+ * length is never truncated.
+ *
+ * @return void
+ */
+int8_t test_memlarge();
+
+/**
+ * @brief function to test the scratch arena
+ * 
+ * This function converts numbers with my_itoa into arena allocated
+ * buffers, then checks alignment, exhaustion and that resetting to a mark
+ * hands the same memory out again.
+ *
+ * @return void
+ */
+int8_t test_arena();
+
+/**
+ * @brief function to test aligned word allocations
+ * 
+ * This function reserves words at 1, 2, 4, 16, 32 and 64 byte and page
+ * alignment, checks the boundary and that the whole block can be written,
+ * and that alignments which are not a power of two are refused.
+ *
+ * @return void
+ */
+int8_t test_aligned();
+
+/**
+ * @brief function to test the compare and search routines
+ * 
+ * This function compares equal and differing runs at unaligned offsets
+ * and searches for present and absent byte values.
+ *
+ * @return void
+ */
+int8_t test_memcmp();
+
+/**
+ * @brief function to test the batched copy
+ * 
+ * This function gathers fragments of 0 to 99 bytes into one run with a
+ * single my_memcopy_batch call and checks every fragment and the byte
+ * just past the run.
+ *
+ * @return void
+ */
+int8_t test_memcopy_batch();
+
+/**
+ * @brief function to test the indexed accessors
+ * 
+ * This function replays the reads and writes of the assignment 2 main
+ * with set_values and get_values and checks the resulting buffer.
+ *
+ * @return void
+ */
+int8_t test_values();
+
+/**
+ * @brief function to test the size specialised copy and fill
+ * 
+ * This function copies and fills constant lengths of 1 to 64 bytes with
+ * my_memcopy_n and my_memset_n at unaligned offsets and checks that the
+ * bytes around each block are left alone.
+ *
+ * @return void
+ */
+int8_t test_memfixed();
+
+/**
+ * @brief function to test the CRC32C checksums
+ * 
+ * This function checks crc32c against the standard check value, that a
+ * checksum split over two calls matches a single call, and that the fused
+ * copy produces both the copy and the same checksum.
+ *
+ * @return void
+ */
+int8_t test_crc32c();
+
+/**
+ * @brief function to test the asynchronous copy engine
+ * 
+ * This function submits dependent copy and fill descriptors, waits on
+ * their tickets and checks the data and the order of the completion
+ * queue.
+ *
+ * @return void
+ */
+int8_t test_dma();
+
+/**
+ * @brief function to test reference counted buffer views
+ * 
+ * This function shares and slices a buffer, checks the reference counts,
+ * and checks that writing through a shared slice copies it while writing
+ * through the last view of a buffer does not.
+ *
+ * @return void
+ */
+int8_t test_buffer();
+
+/**
+ * @brief function to test the single producer, single consumer ring
+ * 
+ * This function fills and drains a ring across its wrap point with bulk
+ * and single byte calls, checks that the order of the bytes is kept, and
+ * checks the capacity of a ring placed in caller memory.
+ *
+ * @return void
+ */
+int8_t test_ring();
+
+/**
+ * @brief function to test the multi producer, multi consumer queue
+ * 
+ * This function fills and drains a queue for several laps from one
+ * thread, checking the rounded capacity, the full and empty results and
+ * that pointers come back in the order they were pushed.
+ *
+ * @return void
+ */
+int8_t test_mpmc();
+
+/**
+ * @brief function to test the streaming copy and fill
+ * 
+ * This function forces non-temporal stores on copies and fills with a
+ * misaligned start and an odd length, and checks every byte written and
+ * the guard bytes on either side of the destination.
+ *
+ * @return void
+ */
+int8_t test_memstream();
+
+/**
+ * @brief function to test the multi-threaded copy and fill
+ * 
+ * This function copies and fills just over MEM_PARALLEL_CUTOFF bytes on
+ * 1, 3 and 64 threads and checks the results against my_memcopy() and
+ * my_memset(), including a guard byte past the end. Host build only.
+ *
+ * @return void
+ */
+int8_t test_memparallel();
+
+/**
+ * @brief function to test element reversal and byte swapping
+ * 
+ * This function runs my_reverse_elements() and my_byteswap() on 1, 2, 4
+ * and 8 byte elements at misaligned addresses, for counts from 0 up to
+ * several vector widths and either side of every vector block size, in
+ * place and between buffers, and checks the whole buffer against a byte
+ * by byte reference.
+ *
+ * @return void
+ */
+int8_t test_elements();
+
+/**
+ * @brief function to test the allocation counters across a reset
+ * 
+ * This function frees a block allocated before mem_stats_reset() and
+ * checks that the cumulative counters restarted while the live byte
+ * counts stayed consistent. Only checks anything when built with
+ * MEM_STATS.
+ *
+ * @return void
+ */
+int8_t test_memstats();
+
+/**
+ * @brief function to test that exiting threads hand their cached blocks back
+ * 
+ * This function starts threads that allocate pool blocks, free only some
+ * or none of them and exit, frees the rest itself, and checks with
+ * pool_class_stats() that every carved block is back in the depot or the
+ * caller's cache. Host build only.
+ *
+ * @return void
+ */
+int8_t test_pool_threads();
+
+/**
+ * @brief function to test huge page backed allocations
+ * 
+ * This function allocates above a small huge page threshold in the
+ * transparent and explicit modes, writes every byte and checks that each
+ * block reports a large request backing and its requested size. Host
+ * build only.
+ *
+ * @return void
+ */
+int8_t test_pool_huge();
+
+
+/**
+ * @brief function to test a ring shared by a producer and a consumer thread
+ * 
+ * This function streams a counting byte sequence from a producer thread
+ * through a small ring that wraps many times and checks on the main thread
+ * that every byte arrives once and in order. Host build only.
+ *
+ * @return void
+ */
+int8_t test_ring_threads();
+
+
+/**
+ * @brief function to test a queue shared by several producers and consumers
+ * 
+ * This function runs two producer and two consumer threads through a small
+ * queue and checks that the items popped sum to the items pushed, with each
+ * item popped exactly once. Host build only.
+ *
+ * @return void
+ */
+int8_t test_mpmc_threads();
+
+
+/**
+ * @brief function to test copies at every alignment
+ * 
+ * This function copies every length around the word, vector block and
+ * streaming threshold sizes between every source and destination
+ * alignment from 0 to 7 and checks the destination and the guard bytes
+ * around it against a byte by byte reference.
+ *
+ * @return void
+ */
+int8_t test_memcopy_align();
+
+
+/**
+ * @brief function to test that copies read nothing past the source
+ * 
+ * This function copies sources at every offset from 1 to 7 that end
+ * exactly at an inaccessible guard page, and from heap blocks of exactly
+ * the source length so that AddressSanitizer builds catch reads into the
+ * redzone behind them. Host build only.
+ *
+ * @return void
+ */
+int8_t test_memcopy_guard();
+
+
+/**
+ * @brief function to test overlapping moves at every alignment
+ * 
+ * This function moves every length around the word, vector block and
+ * streaming threshold sizes between every source and destination
+ * alignment from 0 to 7, with the destination below, inside and above the
+ * source, and checks the whole buffer against a byte by byte reference.
+ *
+ * @return void
+ */
+int8_t test_memmove_align();
+
+
+/**
+ * @brief function to test overlapping moves at the ends of a buffer
+ * 
+ * This function moves sources at every offset from 1 to 7 that end at the
+ * end of a buffer down, and sources that start at its beginning up, by 1
+ * to 7 bytes. The buffers sit between inaccessible guard pages, or are
+ * heap blocks ending with the source so that AddressSanitizer builds catch
+ * reads into the redzone behind them. Host build only.
+ *
+ * @return void
+ */
+int8_t test_memmove_guard();
+
+
+/**
+ * @brief function to test fills at every alignment
+ * 
+ * This function fills and zeroes every length around the word, vector
+ * block and streaming threshold sizes at every destination alignment from
+ * 0 to 7 and checks the destination and the guard bytes around it against
+ * a byte by byte reference.
+ *
+ * @return void
+ */
+int8_t test_memset_align();
+
+
+/**
+ * @brief function to test reversals at every alignment
+ * 
+ * This function reverses every length around the word, vector block and
+ * streaming threshold sizes at every alignment from 0 to 7 and checks the
+ * data and the guard bytes around it against a byte by byte reference.
+ *
+ * @return void
+ */
+int8_t test_reverse_align();
+
 #endif /* __COURSE1_H__ */
 
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file dma.h
+ * @brief Asynchronous DMA style copy engine
+ *
+ * Copy and fill descriptors are submitted to an engine, which runs them in
+ * order in the background while the caller keeps computing. Each submission
+ * returns a ticket to poll or wait on, and finished transfers are reported
+ * through a completion queue.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __DMA_H__
+#define __DMA_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DMA_QUEUE_DEPTH (64)  /* Transfers in flight per engine */
+#define DMA_TICKET_NONE (0)   /* Ticket returned when a submit is refused */
+
+/**
+ * @brief Kind of transfer a descriptor describes.
+ */
+typedef enum {
+  DMA_OP_COPY = 0,  /* Copy length bytes from src to dst */
+  DMA_OP_SET        /* Fill length bytes at dst with value */
+} dma_op_t;
+
+/**
+ * @brief One transfer submitted to an engine.
+ */
+typedef struct {
+  dma_op_t op;      /* DMA_OP_COPY or DMA_OP_SET */
+  uint8_t * src;    /* Source location, unused for DMA_OP_SET */
+  uint8_t * dst;    /* Destination location */
+  size_t length;    /* Length of bytes to transfer */
+  uint8_t value;    /* Fill value for DMA_OP_SET */
+  void * user;      /* Caller data handed back on completion */
+} dma_desc_t;
+
+/**
+ * @brief Sequence number identifying a submitted transfer.
+ */
+typedef uint64_t dma_ticket_t;
+
+/**
+ * @brief Record of a finished transfer taken from the completion queue.
+ */
+typedef struct {
+  dma_ticket_t ticket;  /* Ticket returned by dma_submit() */
+  void * user;          /* User data of the descriptor */
+} dma_completion_t;
+
+/**
+ * @brief Performs transfers for an engine.
+ *
+ * The engine calls transfer once per descriptor, in submission order, and
+ * treats the descriptor as complete when it returns. The default backend
+ * runs the memory.h kernels; a driver for a hardware controller would
+ * start the channel and block until its completion interrupt.
+ */
+typedef struct {
+  const char * name;  /* Reported by dma_backend_name() */
+  void (*transfer)(void * context, const dma_desc_t * desc);
+  void * context;     /* Passed back to transfer */
+} dma_backend_t;
+
+/**
+ * @brief Engine state, private to dma.c.
+ */
+typedef struct dma_engine dma_engine_t;
+
+/**
+ * @brief Creates an engine.
+ *
+ * The host runs the transfers on a background worker thread. The MSP432
+ * has no threads, so its engine runs each transfer inside dma_submit().
+ *
+ * @param backend Pointer to the backend to use, or a Null Pointer for the
+ *                memory.h kernels. The backend must outlive the engine.
+ *
+ * @return Pointer to the engine, or a Null Pointer if out of memory or
+ *         the worker could not be started.
+ */
+dma_engine_t * dma_create(const dma_backend_t * backend);
+
+/**
+ * @brief Waits for every transfer, then destroys an engine.
+ *
+ * @param engine Pointer to the engine, a Null Pointer is ignored.
+ *
+ * @return void.
+ */
+void dma_destroy(dma_engine_t * engine);
+
+/**
+ * @brief Queues a transfer.
+ *
+ * The descriptor is copied, so it may be reused as soon as this returns.
+ * The memory it points at must stay valid until the transfer completes.
+ *
+ * @param engine Pointer to the engine.
+ * @param desc Pointer to the descriptor.
+ *
+ * @return Ticket of the transfer, or DMA_TICKET_NONE if DMA_QUEUE_DEPTH
+ *         transfers are already in flight.
+ */
+dma_ticket_t dma_submit(dma_engine_t * engine, const dma_desc_t * desc);
+
+/**
+ * @brief Checks whether a transfer has completed.
+ *
+ * Transfers complete in submission order, so this also tells that every
+ * earlier transfer has completed.
+ *
+ * @param engine Pointer to the engine.
+ * @param ticket Ticket returned by dma_submit().
+ *
+ * @return Non-zero if the transfer has completed.
+ */
+int dma_poll(dma_engine_t * engine, dma_ticket_t ticket);
+
+/**
+ * @brief Blocks until a transfer has completed.
+ *
+ * @param engine Pointer to the engine.
+ * @param ticket Ticket returned by dma_submit().
+ *
+ * @return void.
+ */
+void dma_wait(dma_engine_t * engine, dma_ticket_t ticket);
+
+/**
+ * @brief Blocks until every submitted transfer has completed.
+ *
+ * @param engine Pointer to the engine.
+ *
+ * @return void.
+ */
+void dma_wait_all(dma_engine_t * engine);
+
+/**
+ * @brief Takes the oldest record off the completion queue.
+ *
+ * The queue holds the last DMA_QUEUE_DEPTH completions; older records
+ * that were never taken are dropped, so callers that only wait on tickets
+ * need not drain it.
+ *
+ * @param engine Pointer to the engine.
+ * @param out Pointer to the record to fill in.
+ *
+ * @return Non-zero if a record was taken, zero if the queue is empty.
+ */
+int dma_reap(dma_engine_t * engine, dma_completion_t * out);
+
+/**
+ * @brief Names the backend of an engine.
+ *
+ * @param engine Pointer to the engine.
+ *
+ * @return Name of the backend, "memory" for the default one.
+ */
+const char * dma_backend_name(dma_engine_t * engine);
+
+#endif /* __DMA_H__ */
@@ -26,11 +26,106 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+/* Default length from which copies and fills switch to non-temporal stores.
+   Hosts that report their last level cache size replace it at startup. */
+#ifndef MEM_STREAM_THRESHOLD
+#define MEM_STREAM_THRESHOLD ((size_t)8 << 20)
+#endif
+
+/* Lengths below this are never split across threads by the parallel
+   variants; thread start-up would cost more than it saves. */
+#ifndef MEM_PARALLEL_CUTOFF
+#define MEM_PARALLEL_CUTOFF ((size_t)4 << 20)
+#endif
+
+/* Bytes ahead of the data being read that copies, scans and reductions
+   prefetch once an operation reaches MEM_PREFETCH_MIN bytes. Hosts can
+   calibrate the distance at run time. Building with PREFETCH=DISABLE
+   (-DMEM_NO_PREFETCH) leaves it all to the hardware prefetcher; the
+   MSP432 has no data cache and never prefetches. */
+#ifndef MEM_PREFETCH_DISTANCE
+#define MEM_PREFETCH_DISTANCE (512)
+#endif
+#define MEM_PREFETCH_MIN      ((size_t)64 << 10)
+#define MEM_PREFETCH_LINE     (64)  /* Bytes covered by one prefetch */
+
+#if !defined(HOST) && !defined(MEM_NO_PREFETCH)
+#define MEM_NO_PREFETCH
+#endif
+
+#if defined(MEM_NO_PREFETCH)
+#define MEM_PREFETCH(addr)       ((void)(addr))
+#define MEM_PREFETCH_WRITE(addr) ((void)(addr))
+#else
+#define MEM_PREFETCH(addr)       __builtin_prefetch((addr), 0, 3)
+#define MEM_PREFETCH_WRITE(addr) __builtin_prefetch((addr), 1, 3)
+#endif
+
+#define MEM_PARALLEL_MAX_THREADS (64)  /* Upper bound on worker threads */
+#define MEM_PARALLEL_ALIGN       (64)  /* Slices meet on destination cache lines */
+
+#define MEM_ALIGN_PAGE  ((size_t)0)  /* reserve_aligned() to the page size */
+#define MEM_PAGE_SIZE   (4096)       /* Page size when the OS cannot be asked */
+
+/* my_memcopy_batch() prefetches the fragments this many descriptors ahead
+   and copies fragments up to MEM_BATCH_SMALL bytes with fixed size moves. */
+#ifndef MEM_BATCH_PREFETCH
+#define MEM_BATCH_PREFETCH (4)
+#endif
+#define MEM_BATCH_SMALL    (16)
+
+/* my_memcopy_n() and my_memset_n() expand lengths that are compile time
+   constants up to this many bytes into straight line loads and stores. */
+#define MEM_CONST_MAX      (64)
+
+/**
+ * @brief Cache policy for the stores of a bulk copy or fill.
+ */
+typedef enum {
+  MEM_STREAM_AUTO = 0, /* Stream from the threshold length upwards */
+  MEM_STREAM_ALWAYS,   /* Always use non-temporal stores */
+  MEM_STREAM_NEVER     /* Always store through the caches */
+} mem_stream_t;
+
+/* 16, 32 and 64 bit elements read or written at any byte address. */
+typedef struct __attribute__((__packed__, __may_alias__)) {
+  uint16_t v;
+} mem_u16_t;
+
+typedef struct __attribute__((__packed__, __may_alias__)) {
+  uint32_t v;
+} mem_u32_t;
+
+typedef struct __attribute__((__packed__, __may_alias__)) {
+  uint64_t v;
+} mem_u64_t;
+
+/* 16 and 32 byte blocks, moved by struct assignment in one or two vector
+   moves on hosts that have them. */
+typedef struct __attribute__((__packed__, __may_alias__)) {
+  uint64_t v[2];
+} mem_u128_t;
+
+typedef struct __attribute__((__packed__, __may_alias__)) {
+  uint64_t v[4];
+} mem_u256_t;
+
+/**
+ * @brief One fragment of a batched copy.
+ */
+typedef struct {
+  uint8_t * src;   /* Source location of the fragment */
+  uint8_t * dst;   /* Destination location of the fragment */
+  size_t length;   /* Length of bytes to copy */
+} mem_copy_desc_t;
+
 /**
  * @brief Sets a value of a data array 
  *
  * Given a pointer to a char data set, this will set a provided
- * index into that data set to the value provided.
+ * index into that data set to the value provided. The accessors are
+ * defined here so callers inline them; memory.c provides the external
+ * definitions used when the compiler chooses not to.
  *
  * @param ptr Pointer to data array
  * @param index Index into pointer array to set value
@@ -38,7 +133,9 @@
  *
  * @return void.
  */
-void set_value(char * ptr, unsigned int index, char value);
+inline void set_value(char * ptr, unsigned int index, char value){
+  ptr[index] = value;
+}
 
 /**
  * @brief Clear a value of a data array 
@@ -51,7 +148,9 @@ void set_value(char * ptr, unsigned int index, char value);
  *
  * @return void.
  */
-void clear_value(char * ptr, unsigned int index);
+inline void clear_value(char * ptr, unsigned int index){
+  set_value(ptr, index, 0);
+}
 
 /**
  * @brief Returns a value of a data array 
@@ -64,7 +163,41 @@ void clear_value(char * ptr, unsigned int index);
  *
  * @return Value to be read.
  */
-char get_value(char * ptr, unsigned int index);
+inline char get_value(char * ptr, unsigned int index){
+  return ptr[index];
+}
+
+/**
+ * @brief Sets data array elements at a list of indices
+ *
+ * Given a pointer to a char data set, this will write values[i] to index
+ * indices[i] for each of the count entries, in order, in a single call.
+ *
+ * @param ptr Pointer to data array
+ * @param indices Indices into the data array to set
+ * @param values Values to write, one per index
+ * @param count Number of entries in indices and values
+ *
+ * @return void.
+ */
+void set_values(char * ptr, const unsigned int * indices, const char * values,
+                size_t count);
+
+/**
+ * @brief Reads data array elements at a list of indices
+ *
+ * Given a pointer to a char data set, this will read index indices[i]
+ * into values[i] for each of the count entries in a single call.
+ *
+ * @param ptr Pointer to data array
+ * @param indices Indices into the data array to read
+ * @param values Array receiving the values, one per index
+ * @param count Number of entries in indices and values
+ *
+ * @return void.
+ */
+void get_values(char * ptr, const unsigned int * indices, char * values,
+                size_t count);
 
 /**
  * @brief Sets data array elements to a value
@@ -125,6 +258,39 @@ uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length);
  */
 uint8_t * my_memcopy(uint8_t * src, uint8_t * dst, size_t length);
 
+/**
+ * @brief Copies bytes, choosing whether the stores bypass the caches.
+ *
+ * Given two pointers to a char data set, this will copy bytes from the
+ * source to the destination like my_memcopy(). Streaming stores write the
+ * destination straight to memory so a large copy does not evict the rest
+ * of the cache. Targets without non-temporal stores ignore the mode.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy from the source to the destination.
+ * @param mode MEM_STREAM_AUTO, MEM_STREAM_ALWAYS or MEM_STREAM_NEVER.
+ *
+ * @return Pointer to the destination location.
+ */
+uint8_t * my_memcopy_stream(uint8_t * src, uint8_t * dst, size_t length,
+                            mem_stream_t mode);
+
+/**
+ * @brief Copies a batch of fragments described by an array of descriptors.
+ *
+ * Given an array of count descriptors, this will copy every fragment from
+ * its source to its destination like my_memcopy(), in order, in a single
+ * call. Scatter and gather copies are batches whose sources or
+ * destinations follow each other. Fragments must not overlap one another.
+ *
+ * @param desc Pointer to the array of descriptors.
+ * @param count Number of descriptors in the array.
+ *
+ * @return Total length of bytes copied.
+ */
+size_t my_memcopy_batch(const mem_copy_desc_t * desc, size_t count);
+
 /**
  * @brief Sets bytes of memory source location with a given value.
  *
@@ -139,6 +305,23 @@ uint8_t * my_memcopy(uint8_t * src, uint8_t * dst, size_t length);
  */
 uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value);
 
+/**
+ * @brief Sets bytes to a value, choosing whether the stores bypass the caches.
+ *
+ * Given pointer to source memory location, this will set bytes in the
+ * source memory location with the given value like my_memset(). Targets
+ * without non-temporal stores ignore the mode.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param value Value to be set in the source memory location.
+ * @param mode MEM_STREAM_AUTO, MEM_STREAM_ALWAYS or MEM_STREAM_NEVER.
+ *
+ * @return Pointer to the source memory location.
+ */
+uint8_t * my_memset_stream(uint8_t * src, size_t length, uint8_t value,
+                           mem_stream_t mode);
+
 /**
  * @brief Sets bytes of memory source location with a zero.
  *
@@ -152,6 +335,167 @@ uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value);
  */
 uint8_t * my_memzero(uint8_t * src, size_t length);
 
+/**
+ * @brief Copies a fixed number of bytes with straight line moves.
+ *
+ * Meant for constant lengths: every test folds away, leaving one move per
+ * set bit of the length, from 32 byte blocks down to a single byte.
+ * Use my_memcopy_n() rather than calling this directly.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy, at most MEM_CONST_MAX.
+ *
+ * @return Pointer to the destination location.
+ */
+static inline __attribute__((__always_inline__))
+uint8_t * mem_copy_const(uint8_t * src, uint8_t * dst, size_t length){
+  size_t i = 0;
+
+  if(length & 64){
+    *(mem_u256_t *)dst = *(const mem_u256_t *)src;
+    *(mem_u256_t *)(dst + 32) = *(const mem_u256_t *)(src + 32);
+    i += 64;
+  }
+  if(length & 32){
+    *(mem_u256_t *)(dst + i) = *(const mem_u256_t *)(src + i);
+    i += 32;
+  }
+  if(length & 16){
+    *(mem_u128_t *)(dst + i) = *(const mem_u128_t *)(src + i);
+    i += 16;
+  }
+  if(length & 8){
+    ((mem_u64_t *)(dst + i))->v = ((const mem_u64_t *)(src + i))->v;
+    i += 8;
+  }
+  if(length & 4){
+    ((mem_u32_t *)(dst + i))->v = ((const mem_u32_t *)(src + i))->v;
+    i += 4;
+  }
+  if(length & 2){
+    ((mem_u16_t *)(dst + i))->v = ((const mem_u16_t *)(src + i))->v;
+    i += 2;
+  }
+  if(length & 1){
+    dst[i] = src[i];
+  }
+  return dst;
+}
+
+/**
+ * @brief Sets a fixed number of bytes with straight line stores.
+ *
+ * Same layout as mem_copy_const(). Use my_memset_n() rather than calling
+ * this directly.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes to set, at most MEM_CONST_MAX.
+ * @param value Value to be set in the source memory location.
+ *
+ * @return Pointer to the source memory location.
+ */
+static inline __attribute__((__always_inline__))
+uint8_t * mem_set_const(uint8_t * src, size_t length, uint8_t value){
+  uint64_t pattern = 0x0101010101010101ull * value;
+  mem_u256_t block = {{pattern, pattern, pattern, pattern}};
+  size_t i = 0;
+
+  if(length & 64){
+    *(mem_u256_t *)src = block;
+    *(mem_u256_t *)(src + 32) = block;
+    i += 64;
+  }
+  if(length & 32){
+    *(mem_u256_t *)(src + i) = block;
+    i += 32;
+  }
+  if(length & 16){
+    ((mem_u64_t *)(src + i))->v = pattern;
+    ((mem_u64_t *)(src + i + 8))->v = pattern;
+    i += 16;
+  }
+  if(length & 8){
+    ((mem_u64_t *)(src + i))->v = pattern;
+    i += 8;
+  }
+  if(length & 4){
+    ((mem_u32_t *)(src + i))->v = (uint32_t)pattern;
+    i += 4;
+  }
+  if(length & 2){
+    ((mem_u16_t *)(src + i))->v = (uint16_t)pattern;
+    i += 2;
+  }
+  if(length & 1){
+    src[i] = value;
+  }
+  return src;
+}
+
+/* Size specialised forms of my_memcopy(), my_memset() and my_memzero().
+   A length that is a compile time constant of at most MEM_CONST_MAX bytes
+   compiles to a few moves with no loop or branch; any other length calls
+   the regular function. Arguments are evaluated once. */
+#define my_memcopy_n(src, dst, length) \
+  ((__builtin_constant_p(length) && ((length) <= MEM_CONST_MAX)) ? \
+   mem_copy_const((src), (dst), (length)) : my_memcopy((src), (dst), (length)))
+
+#define my_memset_n(src, length, value) \
+  ((__builtin_constant_p(length) && ((length) <= MEM_CONST_MAX)) ? \
+   mem_set_const((src), (length), (value)) : my_memset((src), (length), (value)))
+
+#define my_memzero_n(src, length) my_memset_n((src), (length), 0)
+
+/**
+ * @brief Copies bytes from the source to the destination on several threads.
+ *
+ * Given two pointers to a char data set, this will copy bytes from the
+ * source to the destination like my_memcopy(), splitting the work across
+ * threads. Lengths below MEM_PARALLEL_CUTOFF are copied by the caller alone.
+ * Only the host build uses threads; the MSP432 build copies sequentially.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy from the source to the destination.
+ * @param threads Number of threads to use, 0 for one per online CPU.
+ *
+ * @return Pointer to the destination location.
+ */
+uint8_t * my_memcopy_parallel(uint8_t * src, uint8_t * dst, size_t length,
+                              unsigned int threads);
+
+/**
+ * @brief Sets bytes of memory source location with a value on several threads.
+ *
+ * Given pointer to source memory location, this will set bytes in the
+ * source memory location with the given value like my_memset(), splitting
+ * the work across threads. Lengths below MEM_PARALLEL_CUTOFF are set by
+ * the caller alone. Only the host build uses threads.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param value Value to be set in the source memory location.
+ * @param threads Number of threads to use, 0 for one per online CPU.
+ *
+ * @return Pointer to the source memory location.
+ */
+uint8_t * my_memset_parallel(uint8_t * src, size_t length, uint8_t value,
+                             unsigned int threads);
+
+/**
+ * @brief Sets bytes of memory source location with zeros on several threads.
+ *
+ * Same as my_memset_parallel() with a value of zero.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param threads Number of threads to use, 0 for one per online CPU.
+ *
+ * @return Pointer to the source memory location.
+ */
+uint8_t * my_memzero_parallel(uint8_t * src, size_t length, unsigned int threads);
+
 /**
  * @brief Reverses the order of all of the bytes in the source memory location.
  *
@@ -165,6 +509,148 @@ uint8_t * my_memzero(uint8_t * src, size_t length);
  */
 uint8_t * my_reverse(uint8_t * src, size_t length);
 
+/**
+ * @brief Reverses the order of fixed width elements in the source memory location.
+ *
+ * Given pointer to source memory location holding count elements of the
+ * given width, this will reverse the order of the elements while keeping
+ * the byte order inside each element.
+ *
+ * @param src Pointer to source memory location.
+ * @param count Number of elements in the source memory location.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return Pointer to the source memory location, or a Null Pointer if the
+ *         width is not supported.
+ */
+uint8_t * my_reverse_elements(uint8_t * src, size_t count, size_t width);
+
+/**
+ * @brief Byte swaps fixed width elements from the source to the destination.
+ *
+ * Given two pointers to data sets of count elements of the given width,
+ * this will write every source element to the destination with its bytes
+ * reversed, converting between big and little endian in a single pass.
+ * Source and destination may be the same buffer but must not otherwise
+ * overlap.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param count Number of elements to convert.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return Pointer to the destination location, or a Null Pointer if the
+ *         width is not supported.
+ */
+uint8_t * my_byteswap(uint8_t * src, uint8_t * dst, size_t count, size_t width);
+
+/**
+ * @brief Compares bytes of two memory locations.
+ *
+ * Given two pointers to a char data set, this will compare length bytes
+ * as unsigned values, the way memcmp() does.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to compare.
+ *
+ * @return Zero if the regions are equal, otherwise the difference between
+ *         the first pair of bytes that differ, source minus destination.
+ */
+int my_memcmp(uint8_t * src, uint8_t * dst, size_t length);
+
+/**
+ * @brief Finds the first difference between two memory locations.
+ *
+ * Given two pointers to a char data set, this will return the offset of
+ * the first byte that is not the same in both.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to compare.
+ *
+ * @return Index of the first byte that differs, or length if the regions
+ *         are equal.
+ */
+size_t my_memdiff(uint8_t * src, uint8_t * dst, size_t length);
+
+/**
+ * @brief Finds the first occurrence of a byte value in a memory location.
+ *
+ * Given pointer to source memory location, this will search the first
+ * length bytes for the given value.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param value Value to search for.
+ *
+ * @return Pointer to the first matching byte, or a Null Pointer if the
+ *         value does not occur.
+ */
+uint8_t * my_memchr(uint8_t * src, size_t length, uint8_t value);
+
+/**
+ * @brief Names the instruction set used by the memory kernels.
+ *
+ * The widest kernels supported by the CPU are selected once at startup.
+ * Hosts without vector support, and the MSP432, report "scalar".
+ *
+ * @return "scalar", "sse2", "avx2" or "avx512".
+ */
+const char * my_mem_isa(void);
+
+/**
+ * @brief Sets the length from which copies and fills stream past the caches.
+ *
+ * my_memcopy(), my_memset() and my_memzero() use non-temporal stores for
+ * lengths at or above this threshold. Should be set before worker threads
+ * start using the memory functions.
+ *
+ * @param length Threshold in bytes used by MEM_STREAM_AUTO.
+ *
+ * @return void.
+ */
+void my_mem_set_stream_threshold(size_t length);
+
+/**
+ * @brief Returns the length from which copies and fills stream past the caches.
+ *
+ * @return Threshold in bytes used by MEM_STREAM_AUTO.
+ */
+size_t my_mem_stream_threshold(void);
+
+/**
+ * @brief Sets how far ahead large kernels prefetch.
+ *
+ * Should be set before worker threads start using the memory functions.
+ * Ignored when the build disables prefetching.
+ *
+ * @param distance Distance in bytes, 0 to rely on the hardware prefetcher.
+ *
+ * @return void.
+ */
+void my_mem_set_prefetch_distance(size_t distance);
+
+/**
+ * @brief Returns how far ahead large kernels prefetch.
+ *
+ * @return Distance in bytes, 0 when prefetching is off.
+ */
+size_t my_mem_prefetch_distance(void);
+
+/**
+ * @brief Picks the fastest prefetch distance for this machine.
+ *
+ * Times a copy larger than the caches with each candidate distance from 0
+ * to 4 KiB and keeps the fastest. Takes in the order of a few hundred
+ * milliseconds, so call it once at startup, before worker threads run.
+ * Builds without prefetching return 0 straight away.
+ *
+ * @return Distance selected in bytes, 0 when software prefetch does not
+ *         beat the hardware prefetcher.
+ */
+size_t my_mem_calibrate_prefetch(void);
+
 /**
  * @brief Allocates dynamic memory.
  *
@@ -187,4 +673,57 @@ int32_t * reserve_words(size_t length);
  */
 void free_words(uint32_t * src);
 
+/**
+ * @brief Allocates dynamic memory on an alignment boundary.
+ *
+ * Given number of words to be allocated and a power of two alignment, this
+ * reserves the words from the same allocator as reserve_words() with the
+ * first word on the boundary, e.g. 16, 32 or 64 bytes for vector loads and
+ * cache lines. MEM_ALIGN_PAGE aligns to the page size. Alignments of 1 and 2
+ * are accepted and give word aligned memory like reserve_words().
+ *
+ * @param length Number of words to allocate.
+ * @param alignment Alignment in bytes, or MEM_ALIGN_PAGE.
+ *
+ * @return Pointer to the aligned memory if successful, or a Null Pointer
+ *         if not successful or the alignment is not a power of two.
+ */
+int32_t * reserve_aligned(size_t length, size_t alignment);
+
+/**
+ * @brief Frees memory reserved by reserve_aligned().
+ *
+ * free_words() accepts the same pointers; this is provided for symmetry.
+ *
+ * @param src Pointer to the aligned memory location.
+ *
+ * @return void.
+ */
+void free_aligned(uint32_t * src);
+
+/**
+ * @brief Allocates aligned dynamic memory on behalf of a call site.
+ *
+ * Common implementation of reserve_words() and reserve_aligned(). When the
+ * build defines MEM_STATS both are redirected here with the caller's file
+ * and line so the allocator statistics can be broken down by call site.
+ *
+ * @param length Number of words to allocate.
+ * @param alignment Alignment in bytes, or MEM_ALIGN_PAGE.
+ * @param file Source file of the call, or a Null Pointer.
+ * @param line Source line of the call.
+ *
+ * @return Pointer to the aligned memory if successful, or a Null Pointer
+ *         if not successful or the alignment is not a power of two.
+ */
+int32_t * reserve_aligned_at(size_t length, size_t alignment,
+                             const char * file, unsigned int line);
+
+#if defined(MEM_STATS)
+#define reserve_words(length) \
+  reserve_aligned_at((length), sizeof(int32_t), __FILE__, __LINE__)
+#define reserve_aligned(length, alignment) \
+  reserve_aligned_at((length), (alignment), __FILE__, __LINE__)
+#endif
+
 #endif /* __MEMORY_H__ */
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file memstats.h
+ * @brief Allocation counters for the word allocator
+ *
+ * When the build defines MEM_STATS (make MEMSTATS=ENABLE) every
+ * reserve_words()/reserve_aligned() and free_words()/free_aligned() call
+ * updates these counters and is attributed to the file and line that made
+ * the request. Without the flag nothing is recorded and the hooks compile
+ * away.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __MEMSTATS_H__
+#define __MEMSTATS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MEM_STATS_BUCKETS  (32)      /* Histogram buckets, one per power of two */
+#define MEM_STATS_SITES    (64)      /* Call sites tracked individually */
+#define MEM_STATS_NO_SITE  (0xFFFF)  /* Site of untagged or overflow requests */
+
+/**
+ * @brief Counters of one call site.
+ */
+typedef struct {
+  const char * file;   /* Source file of the call, NULL if the slot is free */
+  unsigned int line;   /* Source line of the call */
+  size_t allocs;       /* Successful allocations */
+  size_t frees;        /* Blocks freed */
+  size_t live_bytes;   /* Bytes allocated and not yet freed */
+} mem_stats_site_t;
+
+/**
+ * @brief Snapshot of all allocator counters.
+ */
+typedef struct {
+  size_t allocs;       /* Successful allocations */
+  size_t frees;        /* Blocks freed */
+  size_t failures;     /* Allocations that returned a Null Pointer */
+  size_t live_bytes;   /* Bytes allocated and not yet freed */
+  size_t peak_bytes;   /* High-water mark of live_bytes */
+  size_t histogram[MEM_STATS_BUCKETS]; /* Allocations by floor(log2(size)) */
+  mem_stats_site_t sites[MEM_STATS_SITES];
+} mem_stats_t;
+
+/**
+ * @brief Records an allocation.
+ *
+ * @param size Number of bytes requested.
+ * @param ok Non-zero if the allocation succeeded.
+ * @param file Source file of the call, or a Null Pointer if unknown.
+ * @param line Source line of the call.
+ *
+ * @return Site index to store with the block for mem_stats_free().
+ */
+uint16_t mem_stats_alloc(size_t size, int ok, const char * file, unsigned int line);
+
+/**
+ * @brief Records a free.
+ *
+ * @param size Number of bytes the block was allocated with.
+ * @param site Site index returned by mem_stats_alloc().
+ *
+ * @return void.
+ */
+void mem_stats_free(size_t size, uint16_t site);
+
+/**
+ * @brief Copies the current counters.
+ *
+ * Counters are read one by one while other threads may be updating them,
+ * so totals can be off by in-flight operations.
+ *
+ * @param out Pointer to the snapshot to fill in.
+ *
+ * @return void.
+ */
+void mem_stats_snapshot(mem_stats_t * out);
+
+/**
+ * @brief Starts a new measurement interval.
+ *
+ * Clears the cumulative counters: allocs, frees, failures, the histogram
+ * and the per site allocs and frees. Blocks allocated before the reset are
+ * still out, so live_bytes and the per site live_bytes are kept, call
+ * sites keep their slots, and peak_bytes restarts from the current
+ * live_bytes. Frees after a reset can therefore outnumber allocs.
+ *
+ * @return void.
+ */
+void mem_stats_reset(void);
+
+/**
+ * @brief Prints the counters as "mem_stats,<key>,<value>" CSV lines.
+ *
+ * @return void.
+ */
+void mem_stats_print(void);
+
+#endif /* __MEMSTATS_H__ */
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file mpmc.h
+ * @brief Bounded lock-free multi producer, multi consumer queue
+ *
+ * Any number of threads may push and pop pointers at once without a lock,
+ * for fanning work out to a pool of workers and collecting their results.
+ * Every slot carries a sequence number that says whether it is waiting for
+ * a producer or a consumer of the current lap, so each side claims a slot
+ * with one compare and swap on its own position (Dmitry Vyukov's bounded
+ * queue).
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __MPMC_H__
+#define __MPMC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MPMC_MIN_CAPACITY (2)  /* Smallest capacity the sequence scheme allows */
+
+/**
+ * @brief Queue state, defined in mpmc.c.
+ */
+typedef struct mpmc mpmc_t;
+
+/**
+ * @brief Creates a queue.
+ *
+ * The queue comes from the word allocator, like reserve_words().
+ *
+ * @param capacity Pointers the queue holds, rounded up to a power of two
+ *                 of at least MPMC_MIN_CAPACITY.
+ *
+ * @return Pointer to the queue, or a Null Pointer if out of memory.
+ */
+mpmc_t * mpmc_create(size_t capacity);
+
+/**
+ * @brief Destroys a queue.
+ *
+ * No thread may be using the queue. Pointers still queued are dropped.
+ *
+ * @param queue Pointer to the queue, a Null Pointer is ignored.
+ *
+ * @return void.
+ */
+void mpmc_destroy(mpmc_t * queue);
+
+/**
+ * @brief Enqueues a pointer. Safe from any number of threads.
+ *
+ * @param queue Pointer to the queue.
+ * @param item Pointer to enqueue.
+ *
+ * @return 1 if the pointer was enqueued, 0 if the queue is full.
+ */
+int mpmc_push(mpmc_t * queue, void * item);
+
+/**
+ * @brief Dequeues the oldest pointer. Safe from any number of threads.
+ *
+ * @param queue Pointer to the queue.
+ * @param item Pointer to the pointer to fill in.
+ *
+ * @return 1 if a pointer was dequeued, 0 if the queue is empty.
+ */
+int mpmc_pop(mpmc_t * queue, void ** item);
+
+/**
+ * @brief Returns the capacity of a queue.
+ *
+ * @param queue Pointer to the queue.
+ *
+ * @return Pointers the queue holds when full.
+ */
+size_t mpmc_capacity(const mpmc_t * queue);
+
+#endif /* __MPMC_H__ */
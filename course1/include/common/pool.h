@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file pool.h
+ * @brief Fixed size block pool backing the word allocator
+ *
+ * Small requests are served from per size class free lists carved out of
+ * larger slabs. The lists are shared and, on the host, guarded by a
+ * spinlock; each thread also caches a few free blocks per size class, so
+ * most allocations and frees are a pointer pop or push that skips the
+ * lock. Larger requests go straight to the C library heap.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define POOL_CLASS_COUNT  (8)       /* Number of size classes */
+#define POOL_MIN_BLOCK    (32)      /* Bytes in a block of the smallest class */
+#define POOL_MAX_BLOCK    (POOL_MIN_BLOCK << (POOL_CLASS_COUNT - 1))
+#define POOL_HEADER_SIZE  (16)      /* Bytes in front of every payload */
+#define POOL_CLASS_LARGE  (0xFFFF)  /* Size class of heap backed requests */
+#define POOL_CLASS_THP    (0xFFFE)  /* Size class of transparent huge page maps */
+#define POOL_CLASS_HUGETLB (0xFFFD) /* Size class of hugetlbfs maps */
+#define POOL_MAX_ALIGN    ((size_t)1 << 30)  /* Largest payload alignment */
+
+#define POOL_CACHE_LIMIT  (64)    /* Free blocks a thread keeps per size class */
+#define POOL_CACHE_BATCH  (32)    /* Blocks moved between cache and depot */
+
+/* Huge page size used when the kernel does not report one. The pool reads
+   the hugetlbfs page size from /proc/meminfo and the transparent huge page
+   size from sysfs once, on the first huge page request. */
+#define POOL_HUGE_PAGE    ((size_t)2 << 20)
+
+/* Default huge page policy and the request size from which it applies.
+   Override with -DPOOL_HUGE_MODE=POOL_HUGE_TRANSPARENT etc. or at run time
+   with pool_set_huge_mode(). */
+#ifndef POOL_HUGE_MODE
+#define POOL_HUGE_MODE       POOL_HUGE_OFF
+#endif
+#ifndef POOL_HUGE_THRESHOLD
+#define POOL_HUGE_THRESHOLD  ((size_t)32 << 20)
+#endif
+
+/**
+ * @brief How large requests may be backed by huge pages.
+ */
+typedef enum {
+  POOL_HUGE_OFF = 0,     /* Always use the heap */
+  POOL_HUGE_TRANSPARENT, /* Aligned mapping advised with MADV_HUGEPAGE */
+  POOL_HUGE_EXPLICIT     /* MAP_HUGETLB, then transparent, then the heap */
+} pool_huge_t;
+
+/**
+ * @brief Memory a block was carved from.
+ */
+typedef enum {
+  POOL_BACKING_SLAB = 0, /* Size class slab */
+  POOL_BACKING_HEAP,     /* C library heap */
+  POOL_BACKING_THP,      /* Mapping advised for transparent huge pages */
+  POOL_BACKING_HUGETLB   /* Explicit hugetlbfs pages */
+} pool_backing_t;
+
+/**
+ * @brief Block counts of one size class, see pool_class_stats().
+ */
+typedef struct {
+  size_t carved;  /* Blocks carved from slabs since start up */
+  size_t depot;   /* Free blocks in the shared depot */
+  size_t cached;  /* Free blocks in the calling thread's cache */
+} pool_class_stats_t;
+
+/* Bytes requested from the heap each time a size class runs dry. */
+#ifndef POOL_SLAB_SIZE
+#if defined (MSP432)
+#define POOL_SLAB_SIZE    ((size_t)4 << 10)
+#else
+#define POOL_SLAB_SIZE    ((size_t)64 << 10)
+#endif
+#endif
+
+/**
+ * @brief Allocates a block of at least the given size.
+ *
+ * Requests up to POOL_MAX_BLOCK - POOL_HEADER_SIZE bytes are taken from the
+ * free list of the smallest fitting size class. The payload is aligned to
+ * POOL_HEADER_SIZE bytes.
+ *
+ * @param size Number of bytes requested.
+ *
+ * @return Pointer to the payload, or a Null Pointer if out of memory.
+ */
+void * pool_alloc(size_t size);
+
+/**
+ * @brief Allocates a block whose payload has the given alignment.
+ *
+ * The block is over-sized by the alignment so the payload can be moved up
+ * to the boundary; it is freed with pool_free() like any other block.
+ *
+ * @param size Number of bytes requested.
+ * @param alignment Power of two alignment of the payload.
+ *
+ * @return Pointer to the payload, or a Null Pointer if out of memory or the
+ *         alignment is not a power of two.
+ */
+void * pool_alloc_aligned(size_t size, size_t alignment);
+
+/**
+ * @brief Returns a block to the pool.
+ *
+ * Pool blocks are pushed on the calling thread's cache for their size
+ * class, which hands a batch back to the shared free list once it holds
+ * more than POOL_CACHE_LIMIT blocks. Heap backed blocks are released to the
+ * C library. A Null Pointer is ignored.
+ *
+ * @param ptr Pointer returned by pool_alloc().
+ *
+ * @return void.
+ */
+void pool_free(void * ptr);
+
+/**
+ * @brief Returns the size a block was requested with.
+ *
+ * @param ptr Pointer returned by pool_alloc() or pool_alloc_aligned().
+ *
+ * @return Number of bytes requested.
+ */
+size_t pool_size(const void * ptr);
+
+/**
+ * @brief Returns the caller defined tag of a block.
+ *
+ * @param ptr Pointer returned by pool_alloc() or pool_alloc_aligned().
+ *
+ * @return Tag last set with pool_set_tag(), 0 by default.
+ */
+uint16_t pool_tag(const void * ptr);
+
+/**
+ * @brief Stores a caller defined tag in the header of a block.
+ *
+ * @param ptr Pointer returned by pool_alloc() or pool_alloc_aligned().
+ * @param tag Value to store.
+ *
+ * @return void.
+ */
+void pool_set_tag(void * ptr, uint16_t tag);
+
+/**
+ * @brief Selects whether large requests are backed by huge pages.
+ *
+ * Applies to requests of at least threshold bytes made after the call.
+ * Huge pages are only available on Linux hosts; elsewhere, or when the
+ * kernel refuses, requests fall back to the heap. pool_backing() reports
+ * what each block actually got.
+ *
+ * @param mode POOL_HUGE_OFF, POOL_HUGE_TRANSPARENT or POOL_HUGE_EXPLICIT.
+ * @param threshold Smallest request in bytes that uses huge pages.
+ *
+ * @return void.
+ */
+void pool_set_huge_mode(pool_huge_t mode, size_t threshold);
+
+/**
+ * @brief Reports the memory a block was carved from.
+ *
+ * POOL_BACKING_THP means the mapping was aligned and advised; whether the
+ * kernel actually promoted it depends on the transparent huge page setting.
+ *
+ * @param ptr Pointer returned by pool_alloc() or pool_alloc_aligned().
+ *
+ * @return Backing of the block.
+ */
+pool_backing_t pool_backing(const void * ptr);
+
+/**
+ * @brief Names a backing for logs.
+ *
+ * @param backing Value returned by pool_backing().
+ *
+ * @return "slab", "heap", "thp" or "hugetlb".
+ */
+const char * pool_backing_name(pool_backing_t backing);
+
+/**
+ * @brief Counts the blocks of the size class serving a request size.
+ *
+ * Walks the depot under the lock, so it is meant for tests and
+ * diagnostics rather than hot paths. Once every block of the class has
+ * been freed and every other thread that used it has exited, carved
+ * equals depot plus cached.
+ *
+ * @param size Number of payload bytes, as passed to pool_alloc().
+ * @param out Pointer to the counts to fill in, all 0 for heap sized requests.
+ *
+ * @return void.
+ */
+void pool_class_stats(size_t size, pool_class_stats_t * out);
+
+#endif /* __POOL_H__ */
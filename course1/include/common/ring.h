@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file ring.h
+ * @brief Lock-free single producer, single consumer byte ring
+ *
+ * One context writes and one other context reads, with no lock between
+ * them: each side owns one index and only publishes it after its bytes
+ * are in place. The producer may be a second thread or a signal handler
+ * (the host stand-in for an ISR) as long as there is only one of each.
+ * The capacity is a power of two so indices wrap with a mask, and the two
+ * indices sit on separate cache lines so the sides do not share a line.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+#ifndef __RING_H__
+#define __RING_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined (HOST)
+#define RING_CACHE_LINE (64)  /* Spacing of the producer and consumer fields */
+#else
+#define RING_CACHE_LINE (4)   /* The MSP432 has no data cache to share */
+#endif
+
+/**
+ * @brief Ring bookkeeping, stored at the start of its own region.
+ *
+ * Indices run freely and are masked on use, so head - tail is the fill
+ * level. Each side keeps a copy of the other's index and only reloads it
+ * when the copy says the ring is full or empty.
+ */
+typedef struct {
+  uint8_t * data;   /* First byte of the storage */
+  size_t mask;      /* Capacity - 1 */
+  uint8_t backing;  /* How the region was obtained, see ring.c */
+
+  /* Producer side */
+  size_t head __attribute__((aligned(RING_CACHE_LINE)));  /* Bytes written */
+  size_t tail_cache;  /* Last tail seen by the producer */
+
+  /* Consumer side */
+  size_t tail __attribute__((aligned(RING_CACHE_LINE)));  /* Bytes read */
+  size_t head_cache;  /* Last head seen by the consumer */
+} ring_t;
+
+/**
+ * @brief Creates a ring with its own storage.
+ *
+ * The storage comes from the word allocator, like reserve_words().
+ *
+ * @param capacity Bytes the ring holds, rounded up to a power of two.
+ *
+ * @return Pointer to the ring, or a Null Pointer if out of memory.
+ */
+ring_t * ring_create(size_t capacity);
+
+/**
+ * @brief Creates a ring inside caller provided memory.
+ *
+ * Useful for a static buffer on the MSP432. The bookkeeping is taken from
+ * the start of the buffer and the capacity is the largest power of two
+ * that fits in the rest. ring_destroy() leaves the buffer untouched.
+ *
+ * @param buffer Pointer to the memory to manage.
+ * @param size Length of bytes of the buffer.
+ *
+ * @return Pointer to the ring, or a Null Pointer if the buffer is too small.
+ */
+ring_t * ring_init(void * buffer, size_t size);
+
+/**
+ * @brief Destroys a ring and releases its storage.
+ *
+ * @param ring Pointer to the ring, a Null Pointer is ignored.
+ *
+ * @return void.
+ */
+void ring_destroy(ring_t * ring);
+
+/**
+ * @brief Enqueues as many bytes as fit. Producer only.
+ *
+ * The bytes are copied with my_memcopy in at most two contiguous spans and
+ * published to the consumer together.
+ *
+ * @param ring Pointer to the ring.
+ * @param src Pointer to the bytes to enqueue.
+ * @param length Length of bytes to enqueue.
+ *
+ * @return Number of bytes enqueued, less than length if the ring filled.
+ */
+size_t ring_write(ring_t * ring, const uint8_t * src, size_t length);
+
+/**
+ * @brief Dequeues as many bytes as are available. Consumer only.
+ *
+ * The bytes are copied with my_memcopy in at most two contiguous spans and
+ * their space is handed back to the producer together.
+ *
+ * @param ring Pointer to the ring.
+ * @param dst Pointer to the destination location.
+ * @param length Most bytes to dequeue.
+ *
+ * @return Number of bytes dequeued, less than length if the ring emptied.
+ */
+size_t ring_read(ring_t * ring, uint8_t * dst, size_t length);
+
+/**
+ * @brief Enqueues one byte. Producer only.
+ *
+ * @param ring Pointer to the ring.
+ * @param value Byte to enqueue.
+ *
+ * @return 1 if the byte was enqueued, 0 if the ring is full.
+ */
+int ring_put(ring_t * ring, uint8_t value);
+
+/**
+ * @brief Dequeues one byte. Consumer only.
+ *
+ * @param ring Pointer to the ring.
+ * @param value Pointer to the byte to fill in.
+ *
+ * @return 1 if a byte was dequeued, 0 if the ring is empty.
+ */
+int ring_get(ring_t * ring, uint8_t * value);
+
+/**
+ * @brief Returns the number of bytes waiting in a ring.
+ *
+ * Exact when called by either side while the other is idle, otherwise a
+ * snapshot.
+ *
+ * @param ring Pointer to the ring.
+ *
+ * @return Bytes enqueued and not yet dequeued.
+ */
+size_t ring_used(const ring_t * ring);
+
+/**
+ * @brief Returns the capacity of a ring.
+ *
+ * @param ring Pointer to the ring.
+ *
+ * @return Bytes the ring holds when full.
+ */
+size_t ring_capacity(const ring_t * ring);
+
+#endif /* __RING_H__ */
@@ -12,6 +12,14 @@
 ifeq ($(PLATFORM),MSP432)
 	SOURCES = src/main.c\
 		  src/memory.c\
+		  src/pool.c\
+		  src/arena.c\
+		  src/memstats.c\
+		  src/checksum.c\
+		  src/dma.c\
+		  src/buffer.c\
+		  src/ring.c\
+		  src/mpmc.c\
 		  src/stats.c\
 		  src/course1.c\
 		  src/data.c\
@@ -26,6 +34,14 @@ ifeq ($(PLATFORM),MSP432)
 else
 	SOURCES = src/main.c\
 		  src/memory.c\
+		  src/pool.c\
+		  src/arena.c\
+		  src/memstats.c\
+		  src/checksum.c\
+		  src/dma.c\
+		  src/buffer.c\
+		  src/ring.c\
+		  src/mpmc.c\
 		  src/stats.c\
 		  src/course1.c\
 		  src/data.c
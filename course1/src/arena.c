@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file arena.c
+ * @brief Bump pointer arena for scratch memory
+ *
+ * The arena_t lives at the start of the region it manages, so creating an
+ * arena is a single mapping or allocation and destroying it a single
+ * release.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#if defined (HOST)
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdlib.h>
+#include "../include/common/arena.h"
+
+#if defined (HOST)
+#include <sys/mman.h>
+#endif
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+#define ARENA_BACKING_USER  (0)  /* Caller provided buffer */
+#define ARENA_BACKING_HEAP  (1)  /* C library heap */
+#define ARENA_BACKING_MMAP  (2)  /* Anonymous mapping */
+
+/* Room kept for the arena_t in front of the usable bytes. */
+#define ARENA_HEADER_SIZE \
+  ((sizeof(arena_t) + ARENA_DEFAULT_ALIGN - 1) & ~(size_t)(ARENA_DEFAULT_ALIGN - 1))
+
+/**
+ * @brief Fills in the bookkeeping at the start of a region.
+ *
+ * @param region Pointer to the start of the region.
+ * @param size Length of bytes of the region, header included.
+ * @param backing One of the ARENA_BACKING values.
+ *
+ * @return Pointer to the arena.
+ */
+static arena_t * arena_setup(uint8_t * region, size_t size, uint8_t backing){
+  arena_t * arena = (arena_t *)region;
+
+  arena->base = region + ARENA_HEADER_SIZE;
+  arena->size = size - ARENA_HEADER_SIZE;
+  arena->used = 0;
+  arena->backing = backing;
+  return arena;
+}
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+arena_t * arena_create(size_t size){
+  uint8_t * region;
+  size_t total;
+
+  if(size > (SIZE_MAX - ARENA_HEADER_SIZE)){
+    return NULL;
+  }
+  total = size + ARENA_HEADER_SIZE;
+
+#if defined (HOST)
+  region = (uint8_t *)mmap(NULL, total, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(region == (uint8_t *)MAP_FAILED){
+    return NULL;
+  }
+  return arena_setup(region, total, ARENA_BACKING_MMAP);
+#else
+  region = (uint8_t *)malloc(total);
+  if(region == NULL){
+    return NULL;
+  }
+  return arena_setup(region, total, ARENA_BACKING_HEAP);
+#endif
+}
+
+arena_t * arena_init(void * buffer, size_t size){
+  uintptr_t start = (uintptr_t)buffer;
+  uintptr_t aligned = (start + ARENA_DEFAULT_ALIGN - 1) &
+                      ~(uintptr_t)(ARENA_DEFAULT_ALIGN - 1);
+
+  if((buffer == NULL) || (size < ((aligned - start) + ARENA_HEADER_SIZE))){
+    return NULL;
+  }
+  return arena_setup((uint8_t *)aligned, size - (aligned - start),
+                     ARENA_BACKING_USER);
+}
+
+void * arena_alloc(arena_t * arena, size_t size, size_t alignment){
+  uintptr_t next;
+  size_t offset;
+
+  if(alignment == 0){
+    alignment = ARENA_DEFAULT_ALIGN;
+  }
+  if((alignment & (alignment - 1)) != 0){
+    return NULL;
+  }
+
+  next = (uintptr_t)(arena->base + arena->used);
+  offset = arena->used + (size_t)((alignment - (next & (alignment - 1))) &
+                                  (alignment - 1));
+
+  if((offset > arena->size) || (size > (arena->size - offset))){
+    return NULL;
+  }
+
+  arena->used = offset + size;
+  return arena->base + offset;
+}
+
+arena_mark_t arena_mark(arena_t * arena){
+  return arena->used;
+}
+
+void arena_reset(arena_t * arena, arena_mark_t mark){
+  if(mark < arena->used){
+    arena->used = mark;
+  }
+}
+
+void arena_destroy(arena_t * arena){
+  if(arena == NULL){
+    return;
+  }
+
+  switch(arena->backing){
+#if defined (HOST)
+    case ARENA_BACKING_MMAP:
+      munmap(arena, arena->size + ARENA_HEADER_SIZE);
+      break;
+#endif
+    case ARENA_BACKING_HEAP:
+      free(arena);
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,1065 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file bench.c
+ * @brief Throughput benchmarks for the memory primitives.
+ *
+ * Every data point repeats the operation until roughly BENCH_TARGET_BYTES
+ * have been processed and reports the average throughput.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include "../include/common/bench.h"
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+/**
+ * @brief Returns a monotonic timestamp in seconds.
+ */
+static double bench_now(void){
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/**
+ * @brief Number of calls needed for a data point of the given size.
+ */
+static size_t bench_iterations(size_t size){
+  size_t iterations = BENCH_TARGET_BYTES / size;
+
+  if(iterations == 0){
+    iterations = 1;
+  }
+  if(iterations > BENCH_MAX_ITERATIONS){
+    iterations = BENCH_MAX_ITERATIONS;
+  }
+  return iterations;
+}
+
+/**
+ * @brief Converts bytes processed over an interval into GB/s.
+ */
+static double bench_gbps(size_t size, size_t iterations, double seconds){
+  if(seconds <= 0.0){
+    return 0.0;
+  }
+  return ((double)size * (double)iterations) / seconds / 1e9;
+}
+
+
+/* Primitives covered by the sweeps. */
+typedef enum {
+  BENCH_OP_COPY = 0,
+  BENCH_OP_MOVE,
+  BENCH_OP_SET,
+  BENCH_OP_ZERO,
+  BENCH_OP_REVERSE,
+  BENCH_OP_COUNT
+} bench_op_t;
+
+static const char * const bench_op_names[BENCH_OP_COUNT] = {
+  "memcopy", "memmove", "memset", "memzero", "reverse"
+};
+
+/* The libc routines are called through volatile pointers so the compiler
+   can neither treat them as pure nor expand them inline, which would time
+   something other than the library. */
+static void * (* volatile bench_libc_memcpy)(void *, const void *, size_t) = memcpy;
+static void * (* volatile bench_libc_memmove)(void *, const void *, size_t) = memmove;
+static void * (* volatile bench_libc_memset)(void *, int, size_t) = memset;
+
+/**
+ * @brief Times repeated calls of one primitive.
+ *
+ * @param op Primitive to time.
+ * @param libc Non-zero to time the libc equivalent instead.
+ * @param src Pointer to source location, unused by fills.
+ * @param dst Pointer to destination location.
+ * @param size Length of bytes per call.
+ * @param iterations Number of calls.
+ *
+ * @return Elapsed seconds, or a negative value if libc has no equivalent.
+ */
+static double bench_run(bench_op_t op, int libc, uint8_t * src, uint8_t * dst,
+                        size_t size, size_t iterations){
+  double start = bench_now();
+  size_t i;
+
+  switch(op){
+    case BENCH_OP_COPY:
+      if(libc){
+        for(i = 0; i < iterations; i++){
+          bench_libc_memcpy(dst, src, size);
+        }
+      }else{
+        for(i = 0; i < iterations; i++){
+          my_memcopy(src, dst, size);
+        }
+      }
+      break;
+    case BENCH_OP_MOVE:
+      if(libc){
+        for(i = 0; i < iterations; i++){
+          bench_libc_memmove(dst, src, size);
+        }
+      }else{
+        for(i = 0; i < iterations; i++){
+          my_memmove(src, dst, size);
+        }
+      }
+      break;
+    case BENCH_OP_SET:
+      if(libc){
+        for(i = 0; i < iterations; i++){
+          bench_libc_memset(dst, (int)(i & 0xFF), size);
+        }
+      }else{
+        for(i = 0; i < iterations; i++){
+          my_memset(dst, size, (uint8_t)i);
+        }
+      }
+      break;
+    case BENCH_OP_ZERO:
+      if(libc){
+        for(i = 0; i < iterations; i++){
+          bench_libc_memset(dst, 0, size);
+        }
+      }else{
+        for(i = 0; i < iterations; i++){
+          my_memzero(dst, size);
+        }
+      }
+      break;
+    default:
+      if(libc){
+        return -1.0;
+      }
+      for(i = 0; i < iterations; i++){
+        my_reverse(dst, size);
+      }
+      break;
+  }
+
+  return bench_now() - start;
+}
+
+/**
+ * @brief Prints the column names of the sweep records.
+ *
+ * JSON Lines records name their own fields, so nothing is printed there.
+ */
+static void bench_sweep_header(void){
+#if !defined(BENCH_JSON)
+  PRINTF("function,impl,size_B,src_align,dst_align,overlap_B,GBps,ns_per_call\n");
+#endif
+}
+
+/**
+ * @brief Times one sweep point for both implementations and prints them.
+ *
+ * @param op Primitive to time.
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param size Length of bytes per call.
+ * @param overlap Destination minus source for moves, 0 otherwise.
+ */
+static void bench_sweep_point(bench_op_t op, uint8_t * src, uint8_t * dst,
+                              size_t size, long overlap){
+  size_t iterations = bench_iterations(size);
+  unsigned long src_align = (unsigned long)((uintptr_t)src & (BENCH_SWEEP_ALIGN - 1));
+  unsigned long dst_align = (unsigned long)((uintptr_t)dst & (BENCH_SWEEP_ALIGN - 1));
+  double seconds;
+  int libc;
+
+  for(libc = 0; libc < 2; libc++){
+    seconds = bench_run(op, libc, src, dst, size, iterations);
+    if(seconds < 0.0){
+      continue;
+    }
+#if defined(BENCH_JSON)
+    PRINTF("{\"function\":\"%s\",\"impl\":\"%s\",\"size_B\":%lu,"
+           "\"src_align\":%lu,\"dst_align\":%lu,\"overlap_B\":%ld,"
+           "\"GBps\":%.3f,\"ns_per_call\":%.2f}\n",
+           bench_op_names[op], libc ? "libc" : "my", (unsigned long)size,
+           src_align, dst_align, overlap,
+           bench_gbps(size, iterations, seconds),
+           (seconds * 1e9) / (double)iterations);
+#else
+    PRINTF("%s,%s,%lu,%lu,%lu,%ld,%.3f,%.2f\n",
+           bench_op_names[op], libc ? "libc" : "my", (unsigned long)size,
+           src_align, dst_align, overlap,
+           bench_gbps(size, iterations, seconds),
+           (seconds * 1e9) / (double)iterations);
+#endif
+  }
+}
+
+
+/**
+ * @brief Work of one queue benchmark thread.
+ */
+typedef struct {
+  mpmc_t * queue;     /* Queue under test */
+  size_t first;       /* First item pushed by a producer */
+  size_t count;       /* Items pushed by a producer */
+  size_t * popped;    /* Items popped by all consumers together */
+  uint64_t sum;       /* Sum of the items a consumer popped */
+} bench_mpmc_arg_t;
+
+/**
+ * @brief Pushes items first + 1 to first + count, as pointers.
+ *
+ * Gives up early if the run is abandoned by marking every item popped.
+ *
+ * @param arg Pointer to the bench_mpmc_arg_t of the thread.
+ *
+ * @return Null Pointer.
+ */
+static void * bench_mpmc_producer(void * arg){
+  bench_mpmc_arg_t * work = (bench_mpmc_arg_t *)arg;
+  size_t item;
+
+  for(item = work->first + 1; item <= work->first + work->count; item++){
+    while(! mpmc_push(work->queue, (void *)(uintptr_t)item)){
+      if(__atomic_load_n(work->popped, __ATOMIC_RELAXED) >= BENCH_MPMC_ITEMS){
+        return NULL;
+      }
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Pops and sums items until all BENCH_MPMC_ITEMS have been popped.
+ *
+ * @param arg Pointer to the bench_mpmc_arg_t of the thread.
+ *
+ * @return Null Pointer.
+ */
+static void * bench_mpmc_consumer(void * arg){
+  bench_mpmc_arg_t * work = (bench_mpmc_arg_t *)arg;
+  void * item;
+
+  while(__atomic_load_n(work->popped, __ATOMIC_RELAXED) < BENCH_MPMC_ITEMS){
+    if(mpmc_pop(work->queue, &item)){
+      work->sum += (uintptr_t)item;
+      __atomic_fetch_add(work->popped, 1, __ATOMIC_RELAXED);
+    }else{
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+void bench_scaling(void){
+  uint8_t * src;
+  uint8_t * dst;
+  size_t size;
+  size_t i;
+  size_t iterations;
+  double start;
+  double copy, move, set, zero, reverse;
+
+  /* One extra word so the move can shift the source by one byte. */
+  src = (uint8_t *)reserve_words((BENCH_MAX_SIZE / sizeof(int32_t)) + 2);
+  dst = (uint8_t *)reserve_words((BENCH_MAX_SIZE / sizeof(int32_t)) + 2);
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_scaling: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    return;
+  }
+
+  /* Touch every page up front so first-use faults stay out of the timings. */
+  my_memset(src, BENCH_MAX_SIZE + 1, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE + 1);
+
+  PRINTF("size_B,memcopy_GBps,memmove_GBps,memset_GBps,memzero_GBps,reverse_GBps\n");
+
+  for(size = 1; size <= BENCH_MAX_SIZE; size <<= 1){
+    iterations = bench_iterations(size);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memcopy(src, dst, size);
+    }
+    copy = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memmove(src, src + 1, size);
+    }
+    move = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memset(dst, size, (uint8_t)i);
+    }
+    set = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memzero(dst, size);
+    }
+    zero = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_reverse(dst, size);
+    }
+    reverse = bench_gbps(size, iterations, bench_now() - start);
+
+    PRINTF("%lu,%.3f,%.3f,%.3f,%.3f,%.3f\n", (unsigned long)size,
+           copy, move, set, zero, reverse);
+  }
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+}
+
+void bench_stream(void){
+  uint8_t * src;
+  uint8_t * dst;
+  size_t size;
+  size_t i;
+  size_t iterations;
+  double start;
+  double copy_cached, copy_stream, set_cached, set_stream;
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_stream: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE);
+
+  PRINTF("size_B,memcopy_cached_GBps,memcopy_stream_GBps,"
+         "memset_cached_GBps,memset_stream_GBps\n");
+
+  for(size = BENCH_STREAM_MIN_SIZE; size <= BENCH_MAX_SIZE; size <<= 2){
+    iterations = bench_iterations(size);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memcopy_stream(src, dst, size, MEM_STREAM_NEVER);
+    }
+    copy_cached = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memcopy_stream(src, dst, size, MEM_STREAM_ALWAYS);
+    }
+    copy_stream = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memset_stream(dst, size, (uint8_t)i, MEM_STREAM_NEVER);
+    }
+    set_cached = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memset_stream(dst, size, (uint8_t)i, MEM_STREAM_ALWAYS);
+    }
+    set_stream = bench_gbps(size, iterations, bench_now() - start);
+
+    PRINTF("%lu,%.3f,%.3f,%.3f,%.3f\n", (unsigned long)size,
+           copy_cached, copy_stream, set_cached, set_stream);
+  }
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+}
+
+void bench_parallel(void){
+  uint8_t * src;
+  uint8_t * dst;
+  size_t size;
+  size_t i;
+  size_t iterations;
+  unsigned int threads;
+  double start;
+  double copy, set;
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_parallel: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE);
+
+  PRINTF("size_B,threads,memcopy_GBps,memset_GBps\n");
+
+  for(size = MEM_PARALLEL_CUTOFF; size <= BENCH_MAX_SIZE; size <<= 2){
+    iterations = bench_iterations(size);
+
+    for(threads = 1; threads <= BENCH_MAX_THREADS; threads <<= 1){
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        my_memcopy_parallel(src, dst, size, threads);
+      }
+      copy = bench_gbps(size, iterations, bench_now() - start);
+
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        my_memset_parallel(dst, size, (uint8_t)i, threads);
+      }
+      set = bench_gbps(size, iterations, bench_now() - start);
+
+      PRINTF("%lu,%u,%.3f,%.3f\n", (unsigned long)size, threads, copy, set);
+    }
+  }
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+}
+
+void bench_compare(void){
+  uint8_t * a;
+  uint8_t * b;
+  size_t size;
+  size_t i;
+  size_t iterations;
+  size_t sink = 0;
+  double start;
+  double cmp, libc_cmp, chr, libc_chr;
+  /* Called through volatile pointers so the compiler cannot treat the
+     libc routines as pure and hoist them out of the timing loops. */
+  int (* volatile libc_memcmp)(const void *, const void *, size_t) = memcmp;
+  void * (* volatile libc_memchr)(const void *, int, size_t) = memchr;
+
+  a = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  b = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((a == NULL) || (b == NULL)){
+    PRINTF("bench_compare: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)a);
+    free_words((uint32_t *)b);
+    return;
+  }
+
+  /* Equal buffers without the searched value: every call scans it all. */
+  my_memset(a, BENCH_MAX_SIZE, 0x5A);
+  my_memset(b, BENCH_MAX_SIZE, 0x5A);
+
+  PRINTF("size_B,memcmp_GBps,libc_memcmp_GBps,memchr_GBps,libc_memchr_GBps\n");
+
+  for(size = 1; size <= BENCH_MAX_SIZE; size <<= 1){
+    iterations = bench_iterations(size);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      sink += (size_t)my_memcmp(a, b, size);
+    }
+    cmp = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      sink += (size_t)libc_memcmp(a, b, size);
+    }
+    libc_cmp = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      sink += (size_t)my_memchr(a, size, 0xA5);
+    }
+    chr = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      sink += (size_t)libc_memchr(a, 0xA5, size);
+    }
+    libc_chr = bench_gbps(size, iterations, bench_now() - start);
+
+    PRINTF("%lu,%.3f,%.3f,%.3f,%.3f\n", (unsigned long)size,
+           cmp, libc_cmp, chr, libc_chr);
+  }
+
+  /* Keeps the calls from being optimised away. */
+  if(sink != 0){
+    PRINTF("# bench_compare: buffers differ\n");
+  }
+
+  free_words((uint32_t *)a);
+  free_words((uint32_t *)b);
+}
+
+void bench_elements(void){
+  static const size_t widths[] = {2, 4, 8};
+  uint8_t * a;
+  uint8_t * b;
+  size_t size;
+  size_t w;
+  size_t i;
+  size_t iterations;
+  double start;
+  double reverse, swap;
+
+  a = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  b = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((a == NULL) || (b == NULL)){
+    PRINTF("bench_elements: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)a);
+    free_words((uint32_t *)b);
+    return;
+  }
+
+  my_memset(a, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(b, BENCH_MAX_SIZE);
+
+  PRINTF("width_B,size_B,reverse_elements_GBps,byteswap_GBps\n");
+
+  for(w = 0; w < (sizeof(widths) / sizeof(widths[0])); w++){
+    for(size = 16; size <= BENCH_MAX_SIZE; size <<= 1){
+      iterations = bench_iterations(size);
+
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        my_reverse_elements(a, size / widths[w], widths[w]);
+      }
+      reverse = bench_gbps(size, iterations, bench_now() - start);
+
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        my_byteswap(a, b, size / widths[w], widths[w]);
+      }
+      swap = bench_gbps(size, iterations, bench_now() - start);
+
+      PRINTF("%lu,%lu,%.3f,%.3f\n", (unsigned long)widths[w],
+             (unsigned long)size, reverse, swap);
+    }
+  }
+
+  free_words((uint32_t *)a);
+  free_words((uint32_t *)b);
+}
+
+void bench_batch(void){
+  uint8_t * src;
+  uint8_t * dst;
+  mem_copy_desc_t * desc;
+  size_t stride = BENCH_MAX_SIZE / BENCH_BATCH_COUNT;
+  size_t size;
+  size_t i;
+  size_t j;
+  size_t iterations;
+  double start;
+  double single, batch;
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  desc = (mem_copy_desc_t *)reserve_words(
+    (BENCH_BATCH_COUNT * sizeof(mem_copy_desc_t)) / sizeof(int32_t));
+  if((src == NULL) || (dst == NULL) || (desc == NULL)){
+    PRINTF("bench_batch: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    free_words((uint32_t *)desc);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE);
+
+  PRINTF("fragment_B,memcopy_GBps,memcopy_batch_GBps\n");
+
+  for(size = 1; (size <= 1024) && (size <= stride); size <<= 1){
+    /* Odd offsets so fragments are neither aligned nor cache line sized. */
+    for(j = 0; j < BENCH_BATCH_COUNT; j++){
+      desc[j].src = src + (j * stride) + (j & 7);
+      desc[j].dst = dst + (j * size);
+      desc[j].length = size;
+    }
+    iterations = bench_iterations(size * BENCH_BATCH_COUNT);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      for(j = 0; j < BENCH_BATCH_COUNT; j++){
+        my_memcopy(desc[j].src, desc[j].dst, desc[j].length);
+      }
+    }
+    single = bench_gbps(size * BENCH_BATCH_COUNT, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memcopy_batch(desc, BENCH_BATCH_COUNT);
+    }
+    batch = bench_gbps(size * BENCH_BATCH_COUNT, iterations, bench_now() - start);
+
+    PRINTF("%lu,%.3f,%.3f\n", (unsigned long)size, single, batch);
+  }
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+  free_words((uint32_t *)desc);
+}
+
+void bench_crc32c(void){
+  uint8_t * src;
+  uint8_t * dst;
+  size_t size;
+  size_t i;
+  size_t iterations;
+  uint32_t sink = 0;
+  double start;
+  double crc, two_pass, fused;
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_crc32c: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE);
+
+  PRINTF("size_B,crc32c_GBps,memcopy_then_crc32c_GBps,crc32c_copy_GBps\n");
+
+  for(size = BENCH_STREAM_MIN_SIZE; size <= BENCH_MAX_SIZE; size <<= 2){
+    iterations = bench_iterations(size);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      sink ^= crc32c(src, size, 0);
+    }
+    crc = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      my_memcopy(src, dst, size);
+      sink ^= crc32c(dst, size, 0);
+    }
+    two_pass = bench_gbps(size, iterations, bench_now() - start);
+
+    start = bench_now();
+    for(i = 0; i < iterations; i++){
+      sink ^= crc32c_copy(src, dst, size, 0);
+    }
+    fused = bench_gbps(size, iterations, bench_now() - start);
+
+    PRINTF("%lu,%.3f,%.3f,%.3f\n", (unsigned long)size, crc, two_pass, fused);
+  }
+
+  /* Keeps the checksums from being optimised away. */
+  PRINTF("# crc32c: %s, %08lx\n", crc32c_isa(), (unsigned long)sink);
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+}
+
+void bench_dma(void){
+  uint8_t * src;
+  uint8_t * work[2];
+  dma_engine_t * engine;
+  dma_desc_t desc;
+  dma_ticket_t ticket;
+  size_t blocks = BENCH_MAX_SIZE / BENCH_DMA_BLOCK;
+  size_t i;
+  unsigned int sink = 0;
+  double start;
+  double serial, overlapped;
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  work[0] = (uint8_t *)reserve_words(BENCH_DMA_BLOCK / sizeof(int32_t));
+  work[1] = (uint8_t *)reserve_words(BENCH_DMA_BLOCK / sizeof(int32_t));
+  engine = dma_create(NULL);
+  if((src == NULL) || (work[0] == NULL) || (work[1] == NULL) ||
+     (engine == NULL) || (blocks == 0)){
+    PRINTF("bench_dma: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)work[0]);
+    free_words((uint32_t *)work[1]);
+    dma_destroy(engine);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(work[0], BENCH_DMA_BLOCK);
+  my_memzero(work[1], BENCH_DMA_BLOCK);
+
+  /* Copy a block, then compute on it. */
+  start = bench_now();
+  for(i = 0; i < blocks; i++){
+    my_memcopy(src + (i * BENCH_DMA_BLOCK), work[i & 1], BENCH_DMA_BLOCK);
+    sink += find_mean(work[i & 1], BENCH_DMA_BLOCK);
+    sink += find_maximum(work[i & 1], BENCH_DMA_BLOCK);
+  }
+  serial = bench_gbps(BENCH_MAX_SIZE, 1, bench_now() - start);
+
+  /* Compute on one block while the engine fetches the next. */
+  desc.op = DMA_OP_COPY;
+  desc.value = 0;
+  desc.user = NULL;
+  desc.length = BENCH_DMA_BLOCK;
+
+  start = bench_now();
+  desc.src = src;
+  desc.dst = work[0];
+  ticket = dma_submit(engine, &desc);
+  for(i = 0; i < blocks; i++){
+    dma_wait(engine, ticket);
+    if((i + 1) < blocks){
+      desc.src = src + ((i + 1) * BENCH_DMA_BLOCK);
+      desc.dst = work[(i + 1) & 1];
+      ticket = dma_submit(engine, &desc);
+    }
+    sink += find_mean(work[i & 1], BENCH_DMA_BLOCK);
+    sink += find_maximum(work[i & 1], BENCH_DMA_BLOCK);
+  }
+  overlapped = bench_gbps(BENCH_MAX_SIZE, 1, bench_now() - start);
+
+  PRINTF("block_B,blocks,serial_GBps,overlapped_GBps\n");
+  PRINTF("%lu,%lu,%.3f,%.3f\n", (unsigned long)BENCH_DMA_BLOCK,
+         (unsigned long)blocks, serial, overlapped);
+  PRINTF("# dma: %s, %u\n", dma_backend_name(engine), sink);
+
+  dma_destroy(engine);
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)work[0]);
+  free_words((uint32_t *)work[1]);
+}
+
+void bench_prefetch(void){
+  uint8_t * src;
+  uint8_t * dst;
+  size_t size;
+  size_t i;
+  size_t iterations;
+  size_t distance;
+  size_t pass;
+  size_t sink = 0;
+  double start;
+  double copy[2], chr[2], mean[2];
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_prefetch: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE);
+
+  distance = my_mem_calibrate_prefetch();
+  PRINTF("# calibrated distance %lu B\n", (unsigned long)distance);
+  PRINTF("size_B,memcopy_hw_GBps,memcopy_sw_GBps,memchr_hw_GBps,"
+         "memchr_sw_GBps,find_mean_hw_GBps,find_mean_sw_GBps\n");
+
+  for(size = BENCH_PREFETCH_MIN_SIZE; size <= BENCH_MAX_SIZE; size <<= 2){
+    iterations = bench_iterations(size);
+
+    /* Pass 0 leaves it to the hardware, pass 1 adds software prefetch. */
+    for(pass = 0; pass < 2; pass++){
+      my_mem_set_prefetch_distance((pass == 0) ? 0 : distance);
+
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        my_memcopy_stream(src, dst, size, MEM_STREAM_NEVER);
+      }
+      copy[pass] = bench_gbps(size, iterations, bench_now() - start);
+
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        sink += (size_t)my_memchr(src, size, 0xA5);
+      }
+      chr[pass] = bench_gbps(size, iterations, bench_now() - start);
+
+      start = bench_now();
+      for(i = 0; i < iterations; i++){
+        sink += find_mean(src, (unsigned int)size);
+      }
+      mean[pass] = bench_gbps(size, iterations, bench_now() - start);
+    }
+
+    PRINTF("%lu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", (unsigned long)size,
+           copy[0], copy[1], chr[0], chr[1], mean[0], mean[1]);
+  }
+
+  my_mem_set_prefetch_distance(distance);
+  PRINTF("# prefetch: %lu\n", (unsigned long)sink);
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+}
+
+void bench_sizes(void){
+  uint8_t * src;
+  uint8_t * dst;
+  size_t size;
+  int op;
+
+  src = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(BENCH_MAX_SIZE / sizeof(int32_t));
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_sizes: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_MAX_SIZE);
+    free_words((uint32_t *)src);
+    free_words((uint32_t *)dst);
+    return;
+  }
+
+  my_memset(src, BENCH_MAX_SIZE, 0x5A);
+  my_memzero(dst, BENCH_MAX_SIZE);
+
+  bench_sweep_header();
+  for(size = 1; size <= BENCH_MAX_SIZE; size <<= 1){
+    for(op = 0; op < BENCH_OP_COUNT; op++){
+      bench_sweep_point((bench_op_t)op, src, dst, size, 0);
+    }
+  }
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+}
+
+void bench_alignment(void){
+  static const size_t offsets[] = {0, 1, 2, 3, 4, 7, 8, 15, 16, 31, 32, 63};
+  size_t count = sizeof(offsets) / sizeof(offsets[0]);
+  uint8_t * src;
+  uint8_t * dst;
+  size_t s;
+  size_t d;
+  int op;
+
+  src = (uint8_t *)reserve_aligned((BENCH_SWEEP_SIZE + BENCH_SWEEP_ALIGN) /
+                                   sizeof(int32_t), BENCH_SWEEP_ALIGN);
+  dst = (uint8_t *)reserve_aligned((BENCH_SWEEP_SIZE + BENCH_SWEEP_ALIGN) /
+                                   sizeof(int32_t), BENCH_SWEEP_ALIGN);
+  if((src == NULL) || (dst == NULL)){
+    PRINTF("bench_alignment: unable to reserve %lu bytes\n",
+           (unsigned long)BENCH_SWEEP_SIZE);
+    free_aligned((uint32_t *)src);
+    free_aligned((uint32_t *)dst);
+    return;
+  }
+
+  my_memset(src, BENCH_SWEEP_SIZE + BENCH_SWEEP_ALIGN, 0x5A);
+  my_memzero(dst, BENCH_SWEEP_SIZE + BENCH_SWEEP_ALIGN);
+
+  bench_sweep_header();
+  for(d = 0; d < count; d++){
+    /* Copies and moves pair every destination with every source offset;
+       the other primitives only have a destination. */
+    for(s = 0; s < count; s++){
+      bench_sweep_point(BENCH_OP_COPY, src + offsets[s], dst + offsets[d],
+                        BENCH_SWEEP_SIZE, 0);
+      bench_sweep_point(BENCH_OP_MOVE, src + offsets[s], dst + offsets[d],
+                        BENCH_SWEEP_SIZE, 0);
+    }
+    for(op = BENCH_OP_SET; op < BENCH_OP_COUNT; op++){
+      bench_sweep_point((bench_op_t)op, src, dst + offsets[d],
+                        BENCH_SWEEP_SIZE, 0);
+    }
+  }
+
+  free_aligned((uint32_t *)src);
+  free_aligned((uint32_t *)dst);
+}
+
+void bench_overlap(void){
+  static const long distances[] = {1, 3, 8, 15, 64, 1000, 2048, 4095};
+  size_t count = sizeof(distances) / sizeof(distances[0]);
+  uint8_t * buffer;
+  uint8_t * src;
+  size_t i;
+
+  /* Room for the destination a whole length either side of the source. */
+  buffer = (uint8_t *)reserve_aligned((3 * BENCH_SWEEP_SIZE) / sizeof(int32_t),
+                                      BENCH_SWEEP_ALIGN);
+  if(buffer == NULL){
+    PRINTF("bench_overlap: unable to reserve %lu bytes\n",
+           (unsigned long)(3 * BENCH_SWEEP_SIZE));
+    return;
+  }
+
+  my_memset(buffer, 3 * BENCH_SWEEP_SIZE, 0x5A);
+  src = buffer + BENCH_SWEEP_SIZE;
+
+  bench_sweep_header();
+  for(i = count; i > 0; i--){
+    bench_sweep_point(BENCH_OP_MOVE, src, src - distances[i - 1],
+                      BENCH_SWEEP_SIZE, -distances[i - 1]);
+  }
+  for(i = 0; i < count; i++){
+    bench_sweep_point(BENCH_OP_MOVE, src, src + distances[i],
+                      BENCH_SWEEP_SIZE, distances[i]);
+  }
+
+  free_aligned((uint32_t *)buffer);
+}
+
+void bench_mpmc(void){
+  bench_mpmc_arg_t args[BENCH_MPMC_THREADS];
+  pthread_t threads[BENCH_MPMC_THREADS];
+  uint64_t expected = ((uint64_t)BENCH_MPMC_ITEMS * (BENCH_MPMC_ITEMS + 1)) / 2;
+  uint64_t sum;
+  mpmc_t * queue;
+  size_t producers;
+  size_t consumers;
+  size_t popped;
+  size_t count;
+  size_t done;
+  size_t i;
+  void * item;
+  double seconds;
+  double start;
+
+  PRINTF("threads,producers,consumers,items,Mops,ns_per_item\n");
+  for(count = 1; count <= BENCH_MPMC_THREADS; count <<= 1){
+    queue = mpmc_create(BENCH_MPMC_CAPACITY);
+    if(queue == NULL){
+      PRINTF("bench_mpmc: unable to create a queue\n");
+      return;
+    }
+    sum = 0;
+    popped = 0;
+    producers = count / 2;
+    consumers = count - producers;
+
+    start = bench_now();
+    if(count == 1){
+      /* One thread fills the queue and drains it again */
+      for(done = 0; done < BENCH_MPMC_ITEMS; ){
+        while((done < BENCH_MPMC_ITEMS) &&
+              mpmc_push(queue, (void *)(uintptr_t)(done + 1))){
+          done++;
+        }
+        while(mpmc_pop(queue, &item)){
+          sum += (uintptr_t)item;
+        }
+      }
+    }else{
+      for(i = 0; i < count; i++){
+        args[i].queue = queue;
+        args[i].first = (BENCH_MPMC_ITEMS / producers) * i;
+        args[i].count = (i + 1 == producers) ?
+                        (BENCH_MPMC_ITEMS - args[i].first) :
+                        (BENCH_MPMC_ITEMS / producers);
+        args[i].popped = &popped;
+        args[i].sum = 0;
+      }
+      for(i = 0; i < count; i++){
+        if(pthread_create(&threads[i], NULL, (i < producers) ?
+                          bench_mpmc_producer : bench_mpmc_consumer,
+                          &args[i]) != 0){
+          break;
+        }
+      }
+      if(i < count){
+        /* Marking every item popped stops the threads already running */
+        PRINTF("bench_mpmc: unable to start %lu threads\n",
+               (unsigned long)count);
+        __atomic_store_n(&popped, BENCH_MPMC_ITEMS, __ATOMIC_RELAXED);
+        while(i > 0){
+          pthread_join(threads[--i], NULL);
+        }
+        mpmc_destroy(queue);
+        return;
+      }
+      for(i = 0; i < count; i++){
+        pthread_join(threads[i], NULL);
+        if(i >= producers){
+          sum += args[i].sum;
+        }
+      }
+    }
+    seconds = bench_now() - start;
+    mpmc_destroy(queue);
+
+    if(sum != expected){
+      PRINTF("bench_mpmc: %lu threads lost items\n", (unsigned long)count);
+    }
+    PRINTF("%lu,%lu,%lu,%lu,%.3f,%.2f\n", (unsigned long)count,
+           (unsigned long)producers, (unsigned long)consumers,
+           (unsigned long)BENCH_MPMC_ITEMS,
+           ((double)BENCH_MPMC_ITEMS / seconds) / 1e6,
+           (seconds * 1e9) / (double)BENCH_MPMC_ITEMS);
+  }
+}
+
+void bench(void){
+#if defined(BENCH_JSON)
+  bench_sizes();
+  bench_alignment();
+  bench_overlap();
+#else
+  PRINTF("# isa: %s\n", my_mem_isa());
+  PRINTF("# bench_sizes\n");
+  bench_sizes();
+  PRINTF("# bench_alignment (%lu B)\n", (unsigned long)BENCH_SWEEP_SIZE);
+  bench_alignment();
+  PRINTF("# bench_overlap (%lu B)\n", (unsigned long)BENCH_SWEEP_SIZE);
+  bench_overlap();
+  PRINTF("# bench_scaling\n");
+  bench_scaling();
+  PRINTF("# bench_stream (threshold %lu B)\n",
+         (unsigned long)my_mem_stream_threshold());
+  bench_stream();
+  PRINTF("# bench_parallel\n");
+  bench_parallel();
+  PRINTF("# bench_compare\n");
+  bench_compare();
+  PRINTF("# bench_elements\n");
+  bench_elements();
+  PRINTF("# bench_batch\n");
+  bench_batch();
+  PRINTF("# bench_crc32c\n");
+  bench_crc32c();
+  PRINTF("# bench_dma\n");
+  bench_dma();
+  PRINTF("# bench_prefetch\n");
+  bench_prefetch();
+  PRINTF("# bench_mpmc (capacity %d)\n", BENCH_MPMC_CAPACITY);
+  bench_mpmc();
+#endif
+}
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file buffer.c
+ * @brief Reference counted buffers with zero copy views
+ *
+ * Each buffer is a single reserve_aligned() block: a small header with the
+ * reference count, padded to BUFFER_ALIGN, followed by the bytes. Views
+ * only carry a pointer to the header and their range, so sharing and
+ * slicing never touch the allocator. The count is updated atomically,
+ * letting views of one buffer be released from different threads.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#include "../include/common/buffer.h"
+#include "../include/common/memory.h"
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+struct buffer {
+  uint32_t refs;   /* Views referring to the buffer */
+  size_t length;   /* Length of bytes following the header */
+};
+
+/* Bytes from the header to the first data byte. */
+#define BUFFER_HEADER \
+  ((sizeof(buffer_t) + BUFFER_ALIGN - 1) & ~(size_t)(BUFFER_ALIGN - 1))
+
+#define BUFFER_BYTES(buffer) ((uint8_t *)(buffer) + BUFFER_HEADER)
+
+/**
+ * @brief Returns a view that refers to nothing.
+ *
+ * @return Empty view.
+ */
+static buffer_view_t buffer_empty(void){
+  buffer_view_t view;
+
+  view.buffer = NULL;
+  view.offset = 0;
+  view.length = 0;
+  return view;
+}
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+buffer_view_t buffer_create(size_t length){
+  buffer_view_t view = buffer_empty();
+  buffer_t * buffer;
+  size_t words;
+
+  if((length == 0) || (length > SIZE_MAX - BUFFER_HEADER - sizeof(int32_t))){
+    return view;
+  }
+
+  words = (BUFFER_HEADER + length + sizeof(int32_t) - 1) / sizeof(int32_t);
+  buffer = (buffer_t *)reserve_aligned(words, BUFFER_ALIGN);
+  if(buffer == NULL){
+    return view;
+  }
+
+  buffer->refs = 1;
+  buffer->length = length;
+  view.buffer = buffer;
+  view.length = length;
+  return view;
+}
+
+buffer_view_t buffer_from(const uint8_t * src, size_t length){
+  buffer_view_t view = buffer_create(length);
+
+  if((view.buffer != NULL) && (src != NULL)){
+    my_memcopy((uint8_t *)src, BUFFER_BYTES(view.buffer), length);
+  }
+  return view;
+}
+
+buffer_view_t buffer_share(buffer_view_t view){
+  if(view.buffer != NULL){
+    __atomic_fetch_add(&view.buffer->refs, 1, __ATOMIC_RELAXED);
+  }
+  return view;
+}
+
+buffer_view_t buffer_slice(buffer_view_t view, size_t offset, size_t length){
+  if((view.buffer == NULL) || (offset > view.length) ||
+     (length > view.length - offset)){
+    return buffer_empty();
+  }
+
+  view.offset += offset;
+  view.length = length;
+  return buffer_share(view);
+}
+
+void buffer_release(buffer_view_t * view){
+  if((view == NULL) || (view->buffer == NULL)){
+    return;
+  }
+
+  /* Release orders this view's writes before the free; acquire on the
+     last reference sees every other view's writes. */
+  if(__atomic_sub_fetch(&view->buffer->refs, 1, __ATOMIC_ACQ_REL) == 0){
+    free_aligned((uint32_t *)view->buffer);
+  }
+  *view = buffer_empty();
+}
+
+const uint8_t * buffer_data(buffer_view_t view){
+  if(view.buffer == NULL){
+    return NULL;
+  }
+  return BUFFER_BYTES(view.buffer) + view.offset;
+}
+
+uint8_t * buffer_mutable(buffer_view_t * view){
+  buffer_view_t copy;
+
+  if((view == NULL) || (view->buffer == NULL)){
+    return NULL;
+  }
+
+  /* A sole reference cannot gain another except through this view. */
+  if(__atomic_load_n(&view->buffer->refs, __ATOMIC_ACQUIRE) == 1){
+    return BUFFER_BYTES(view->buffer) + view->offset;
+  }
+
+  copy = buffer_from(buffer_data(*view), view->length);
+  if(copy.buffer == NULL){
+    return NULL;
+  }
+  buffer_release(view);
+  *view = copy;
+  return BUFFER_BYTES(view->buffer);
+}
+
+uint32_t buffer_refs(buffer_view_t view){
+  if(view.buffer == NULL){
+    return 0;
+  }
+  return __atomic_load_n(&view.buffer->refs, __ATOMIC_RELAXED);
+}
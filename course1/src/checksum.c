@@ -0,0 +1,272 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file checksum.c
+ * @brief CRC32C checksums, standalone and fused with a copy
+ *
+ * x86-64 hosts with SSE4.2 use the CRC32 instruction, eight bytes at a
+ * time. Everything else uses slice-by-8 tables, which fold eight bytes
+ * per step with eight independent table lookups.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#include "../include/common/checksum.h"
+#include "../include/common/memory.h"
+
+#if defined(HOST) && defined(__GNUC__) && defined(__x86_64__)
+#define CRC32C_X86
+#include <nmmintrin.h>
+#endif
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+/* Slice-by-8 tables: crc32c_table[0] is the classic byte table and
+   crc32c_table[k] advances a byte through k further zero bytes. */
+static uint32_t crc32c_table[8][256];
+static uint8_t crc32c_ready = 0;
+
+/**
+ * @brief Fills in the slice-by-8 tables.
+ *
+ * @return void.
+ */
+static void crc32c_build(void){
+  uint32_t crc;
+  unsigned int i;
+  unsigned int k;
+
+  for(i = 0; i < 256; i++){
+    crc = i;
+    for(k = 0; k < 8; k++){
+      crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+    }
+    crc32c_table[0][i] = crc;
+  }
+  for(i = 0; i < 256; i++){
+    crc = crc32c_table[0][i];
+    for(k = 1; k < 8; k++){
+      crc = (crc >> 8) ^ crc32c_table[0][crc & 0xFF];
+      crc32c_table[k][i] = crc;
+    }
+  }
+  crc32c_ready = 1;
+}
+
+/**
+ * @brief Folds eight bytes, given as two little endian words, into a CRC.
+ *
+ * @param crc Running CRC, not inverted.
+ * @param one First four bytes.
+ * @param two Last four bytes.
+ *
+ * @return Running CRC after the eight bytes.
+ */
+static uint32_t crc32c_fold8(uint32_t crc, uint32_t one, uint32_t two){
+  one ^= crc;
+  return crc32c_table[7][one & 0xFF] ^
+         crc32c_table[6][(one >> 8) & 0xFF] ^
+         crc32c_table[5][(one >> 16) & 0xFF] ^
+         crc32c_table[4][one >> 24] ^
+         crc32c_table[3][two & 0xFF] ^
+         crc32c_table[2][(two >> 8) & 0xFF] ^
+         crc32c_table[1][(two >> 16) & 0xFF] ^
+         crc32c_table[0][two >> 24];
+}
+
+/**
+ * @brief Computes a running CRC32C with the slice-by-8 tables.
+ *
+ * Big endian targets fold a byte at a time, as the slices assume little
+ * endian words.
+ *
+ * @param crc Running CRC, not inverted.
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes to checksum.
+ *
+ * @return Running CRC after the bytes.
+ */
+static uint32_t crc32c_slice8(uint32_t crc, const uint8_t * src, size_t length){
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  while(length >= 8){
+    crc = crc32c_fold8(crc, ((const mem_u32_t *)src)->v,
+                       ((const mem_u32_t *)(src + 4))->v);
+    src += 8;
+    length -= 8;
+  }
+#endif
+  while(length > 0){
+    crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *src++) & 0xFF];
+    length--;
+  }
+  return crc;
+}
+
+/**
+ * @brief Copies bytes and computes a running CRC32C with the tables.
+ *
+ * @param crc Running CRC, not inverted.
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy.
+ *
+ * @return Running CRC after the bytes.
+ */
+static uint32_t crc32c_copy_slice8(uint32_t crc, const uint8_t * src,
+                                   uint8_t * dst, size_t length){
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  uint32_t one;
+  uint32_t two;
+
+  while(length >= 8){
+    one = ((const mem_u32_t *)src)->v;
+    two = ((const mem_u32_t *)(src + 4))->v;
+    ((mem_u32_t *)dst)->v = one;
+    ((mem_u32_t *)(dst + 4))->v = two;
+    crc = crc32c_fold8(crc, one, two);
+    src += 8;
+    dst += 8;
+    length -= 8;
+  }
+#endif
+  while(length > 0){
+    crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *src) & 0xFF];
+    *dst++ = *src++;
+    length--;
+  }
+  return crc;
+}
+
+#if defined(CRC32C_X86)
+/**
+ * @brief Computes a running CRC32C with the SSE4.2 CRC32 instruction.
+ *
+ * @param crc Running CRC, not inverted.
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes to checksum.
+ *
+ * @return Running CRC after the bytes.
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t * src, size_t length){
+  uint64_t wide = crc;
+
+  while(length >= 8){
+    wide = _mm_crc32_u64(wide, ((const mem_u64_t *)src)->v);
+    src += 8;
+    length -= 8;
+  }
+  crc = (uint32_t)wide;
+  while(length > 0){
+    crc = _mm_crc32_u8(crc, *src++);
+    length--;
+  }
+  return crc;
+}
+
+/**
+ * @brief Copies bytes and computes a running CRC32C with SSE4.2.
+ *
+ * Each word is loaded once, stored to the destination and fed to CRC32.
+ *
+ * @param crc Running CRC, not inverted.
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy.
+ *
+ * @return Running CRC after the bytes.
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_copy_sse42(uint32_t crc, const uint8_t * src,
+                                  uint8_t * dst, size_t length){
+  uint64_t wide = crc;
+  uint64_t word;
+
+  while(length >= 8){
+    word = ((const mem_u64_t *)src)->v;
+    ((mem_u64_t *)dst)->v = word;
+    wide = _mm_crc32_u64(wide, word);
+    src += 8;
+    dst += 8;
+    length -= 8;
+  }
+  crc = (uint32_t)wide;
+  while(length > 0){
+    crc = _mm_crc32_u8(crc, *src);
+    *dst++ = *src++;
+    length--;
+  }
+  return crc;
+}
+#endif /* CRC32C_X86 */
+
+/* Kernels used by the public functions, upgraded at startup by
+   crc32c_dispatch_init() when the CPU has the CRC32 instruction. */
+static struct {
+  const char * isa;
+  uint32_t (*update)(uint32_t crc, const uint8_t * src, size_t length);
+  uint32_t (*copy)(uint32_t crc, const uint8_t * src, uint8_t * dst,
+                   size_t length);
+} crc32c_kernels = {
+  "slice8",
+  crc32c_slice8,
+  crc32c_copy_slice8
+};
+
+#if defined(HOST)
+/**
+ * @brief Builds the tables and selects the kernels before main().
+ *
+ * Running as a constructor keeps the tables read-only once threads exist.
+ *
+ * @return void.
+ */
+__attribute__((constructor))
+static void crc32c_dispatch_init(void){
+  crc32c_build();
+
+#if defined(CRC32C_X86)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("sse4.2")){
+    crc32c_kernels.isa = "sse4.2";
+    crc32c_kernels.update = crc32c_sse42;
+    crc32c_kernels.copy = crc32c_copy_sse42;
+  }
+#endif
+}
+#endif /* HOST */
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+uint32_t crc32c(const uint8_t * src, size_t length, uint32_t crc){
+  if(! crc32c_ready){
+    crc32c_build();
+  }
+  return ~crc32c_kernels.update(~crc, src, length);
+}
+
+uint32_t crc32c_copy(const uint8_t * src, uint8_t * dst, size_t length,
+                     uint32_t crc){
+  if(! crc32c_ready){
+    crc32c_build();
+  }
+  return ~crc32c_kernels.copy(~crc, src, dst, length);
+}
+
+const char * crc32c_isa(void){
+  return crc32c_kernels.isa;
+}
@@ -9,9 +9,48 @@
  *
  *****************************************************************************/
 
+#if defined (HOST)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#endif
 
 #include "../include/common/course1.h"
 
+#if defined (HOST)
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Compares two buffers one byte at a time.
+ *
+ * Tests check the word and vector kernels against this
+ * rather than my_memcmp(), which shares their tricks.
+ *
+ * @param a Pointer to the first buffer.
+ * @param b Pointer to the second buffer.
+ * @param length Length of bytes to compare.
+ *
+ * @return TEST_NO_ERROR if the buffers match, TEST_ERROR otherwise.
+ */
+static int8_t test_bytes_equal(const uint8_t * a, const uint8_t * b,
+                               size_t length)
+{
+  size_t i;
+
+  for (i = 0; i < length; i++)
+  {
+    if (a[i] != b[i])
+    {
+      return TEST_ERROR;
+    }
+  }
+  return TEST_NO_ERROR;
+}
+
 int8_t test_data1() {
   uint8_t * ptr;
   int32_t num = -4096;
@@ -309,29 +348,1895 @@ int8_t test_reverse()
   return ret;
 }
 
-void course1(void) 
+int8_t test_memlarge()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+
+  PRINTF("test_memlarge()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Copy 2000 bytes between unaligned, non-overlapping halves */
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+  my_memcopy(&set[1], &set[2051], 2000);
+  for (i = 0; i < 2000; i++)
+  {
+    if (set[2051 + i] != (uint8_t)((i + 1) * 7))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  /* Move 3000 bytes down by 3 over themselves */
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+  my_memmove(&set[3], &set[0], 3000);
+  for (i = 0; i < 3000; i++)
+  {
+    if (set[i] != (uint8_t)((i + 3) * 7))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  /* Move 3000 bytes up by 5 over themselves */
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+  my_memmove(&set[0], &set[5], 3000);
+  for (i = 0; i < 3000; i++)
+  {
+    if (set[i + 5] != (uint8_t)(i * 7))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  /* Reverse the whole set */
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+  my_reverse(set, MEM_LARGE_SIZE_B);
+  for (i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    if (set[i] != (uint8_t)((MEM_LARGE_SIZE_B - i - 1) * 7))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  /* Set all but the first and last byte */
+  my_memset(&set[1], MEM_LARGE_SIZE_B - 2, 0xA5);
+  for (i = 1; i < MEM_LARGE_SIZE_B - 1; i++)
+  {
+    if (set[i] != 0xA5)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if ((set[0] != (uint8_t)((MEM_LARGE_SIZE_B - 1) * 7)) || (set[MEM_LARGE_SIZE_B - 1] != 0))
+  {
+    ret = TEST_ERROR;
+  }
+
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_arena()
+{
+  int8_t ret = TEST_NO_ERROR;
+  arena_t * arena;
+  arena_mark_t mark;
+  uint8_t * first;
+  uint8_t * second;
+  uint32_t digits;
+
+  PRINTF("test_arena()\n");
+  arena = arena_create(ARENA_SIZE_B);
+  if (! arena )
+  {
+    return TEST_ERROR;
+  }
+
+  mark = arena_mark(arena);
+  first = (uint8_t*)arena_alloc(arena, DATA_SET_SIZE_W * sizeof(int32_t), 0);
+  if (! first )
+  {
+    arena_destroy(arena);
+    return TEST_ERROR;
+  }
+  digits = my_itoa(-4096, first, BASE_10);
+  if (my_atoi(first, digits, BASE_10) != -4096)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Aligned allocations land on the requested boundary */
+  second = (uint8_t*)arena_alloc(arena, 3, 64);
+  if ((! second ) || (((uintptr_t)second & 63) != 0))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Requests past the end fail without disturbing the arena */
+  if (arena_alloc(arena, ARENA_SIZE_B, 0) != NULL)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Resetting to the mark recycles the same memory */
+  arena_reset(arena, mark);
+  if ((uint8_t*)arena_alloc(arena, DATA_SET_SIZE_W * sizeof(int32_t), 0) != first)
+  {
+    ret = TEST_ERROR;
+  }
+
+  arena_destroy(arena);
+  return ret;
+}
+
+int8_t test_aligned()
 {
   uint8_t i;
-  int8_t failed = 0;
-  int8_t results[TESTCOUNT];
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  size_t alignments[7] = {1, 2, 4, 16, 32, 64, MEM_PAGE_SIZE};
 
-  results[0] = test_data1();
-  results[1] = test_data2();
-  results[2] = test_memmove1();
-  results[3] = test_memmove2();
-  results[4] = test_memmove3();
-  results[5] = test_memcopy();
-  results[6] = test_memset();
-  results[7] = test_reverse();
+  PRINTF("test_aligned()\n");
+  for (i = 0; i < 7; i++)
+  {
+    set = (uint8_t*)reserve_aligned(MEM_SET_SIZE_W, alignments[i]);
+    if (! set )
+    {
+      return TEST_ERROR;
+    }
+    /* Alignments below a word still give word aligned memory */
+    if ((((uintptr_t)set & (alignments[i] - 1)) != 0) ||
+        (((uintptr_t)set & (sizeof(int32_t) - 1)) != 0))
+    {
+      ret = TEST_ERROR;
+    }
+    my_memset(set, MEM_SET_SIZE_B, 0xFF);
+    free_aligned( (uint32_t*)set );
+  }
 
-  for ( i = 0; i < TESTCOUNT; i++) 
+  /* Alignments that are not a power of two are refused */
+  if ((reserve_aligned(MEM_SET_SIZE_W, 3) != NULL) ||
+      (reserve_aligned(MEM_SET_SIZE_W, 48) != NULL))
   {
-    failed += results[i];
+    ret = TEST_ERROR;
   }
+  return ret;
+}
 
-  PRINTF("--------------------------------\n");
-  PRINTF("Test Results:\n");
-  PRINTF("  PASSED: %d / %d\n", (TESTCOUNT - failed), TESTCOUNT);
-  PRINTF("  FAILED: %d / %d\n", failed, TESTCOUNT);
-  PRINTF("--------------------------------\n");
+int8_t test_memcmp()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+
+  PRINTF("test_memcmp()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Two equal 2000 byte runs at unaligned offsets */
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i % 200);
+  }
+  if ((my_memcmp(&set[1], &set[2001], 2000) != 0) ||
+      (my_memdiff(&set[1], &set[2001], 2000) != 2000))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* A single changed byte near the end is found and ordered */
+  set[2001 + 1999] = 0xFF;
+  if ((my_memdiff(&set[1], &set[2001], 2000) != 1999) ||
+      (my_memcmp(&set[1], &set[2001], 2000) >= 0) ||
+      (my_memcmp(&set[2001], &set[1], 2000) <= 0))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* The first of several matches is returned, absent values give NULL */
+  if ((my_memchr(&set[3], 1000, 199) != &set[199]) ||
+      (my_memchr(&set[3], 1000, 0xFE) != NULL) ||
+      (my_memchr(set, MEM_LARGE_SIZE_B, 0xFF) != &set[4000]))
+  {
+    ret = TEST_ERROR;
+  }
+
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_memcopy_batch()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  mem_copy_desc_t desc[MEM_BATCH_COUNT];
+  size_t offset = 0;
+  size_t total = 0;
+
+  PRINTF("test_memcopy_batch()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+
+  /* Gather fragments of 0 to 99 bytes spread over the first half into
+     the second half, one after the other */
+  for (i = 0; i < MEM_BATCH_COUNT; i++)
+  {
+    desc[i].src = &set[i * 61];
+    desc[i].dst = &set[2048 + offset];
+    desc[i].length = (i * 13) % 100;
+    offset += desc[i].length;
+    total += desc[i].length;
+  }
+  if (my_memcopy_batch(desc, MEM_BATCH_COUNT) != total)
+  {
+    ret = TEST_ERROR;
+  }
+  for (i = 0; i < MEM_BATCH_COUNT; i++)
+  {
+    if (my_memcmp(desc[i].src, desc[i].dst, desc[i].length) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if (set[2048 + total] != (uint8_t)((2048 + total) * 7))
+  {
+    ret = TEST_ERROR;
+  }
+
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_values()
+{
+  int8_t ret = TEST_NO_ERROR;
+  char buffer[MEM_VALUES_LENGTH];
+  char read[2];
+  const unsigned int read_at[2] = {1, 9};
+  const unsigned int write_at[6] = {0, 3, 1, 4, 2, 5};
+  const char writes[6] = {0x61, 0x37, 88, '2', 121, 0x5F};
+  const char expected[MEM_VALUES_LENGTH] = {'a', 'X', 'y', '7', '2', '_',
+                                            0, 'L', '+', 'R'};
+
+  PRINTF("test_values()\n");
+
+  /* The sparse updates of the assignment 2 main, batched */
+  clear_all(buffer, MEM_VALUES_LENGTH);
+  set_all(&buffer[8], 43, 2);
+  set_values(buffer, write_at, writes, 6);
+  get_values(buffer, read_at, read, 2);
+  set_value(buffer, 7, (char)(read[0] - 12));
+  set_value(buffer, 9, (char)(read[1] + 0x27));
+  if (get_value(buffer, 7) != 'L')
+  {
+    ret = TEST_ERROR;
+  }
+
+  if (my_memcmp((uint8_t*)buffer, (uint8_t*)expected, MEM_VALUES_LENGTH) != 0)
+  {
+    ret = TEST_ERROR;
+  }
+  return ret;
+}
+
+int8_t test_memfixed()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+
+  PRINTF("test_memfixed()\n");
+  set = (uint8_t*)reserve_words(MEM_FIXED_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_FIXED_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)i;
+  }
+
+  /* Constant lengths of every shape, to unaligned destinations */
+  my_memcopy_n(&set[0], &set[129], 64);
+  my_memcopy_n(&set[64], &set[194], MEM_SET_SIZE_B);
+  my_memcopy_n(&set[96], &set[227], TEST_MEMMOVE_LENGTH);
+  my_memcopy_n(&set[112], &set[244], 7);
+  for (i = 0; i < 119; i++)
+  {
+    if (set[129 + i + ((i >= 64) ? 1 : 0) + ((i >= 96) ? 1 : 0) +
+            ((i >= 112) ? 1 : 0)] != (uint8_t)i)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if ((set[128] != 128) || (set[193] != 193) || (set[226] != 226) ||
+      (set[243] != 243) || (set[251] != 251))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Constant and variable length fills agree */
+  my_memset_n(&set[3], 37, 0xA5);
+  my_memset(&set[129], (size_t)set[40] - 3, 0xA5);
+  if ((my_memcmp(&set[3], &set[129], 37) != 0) ||
+      (set[2] != 2) || (set[40] != 40) || (set[166] != 37))
+  {
+    ret = TEST_ERROR;
+  }
+
+  my_memzero_n(&set[1], 1);
+  if (set[1] != 0)
+  {
+    ret = TEST_ERROR;
+  }
+
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_crc32c()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint32_t crc;
+
+  PRINTF("test_crc32c()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Standard check value over "123456789" */
+  for( i = 0; i < 9; i++)
+  {
+    set[i] = (uint8_t)('1' + i);
+  }
+  if (crc32c(set, 9, 0) != CRC32C_CHECK)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Continuing over an unaligned split gives the same checksum */
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+  crc = crc32c(&set[1], 2000, 0);
+  if (crc32c(&set[1 + 777], 2000 - 777, crc32c(&set[1], 777, 0)) != crc)
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* The fused copy checksums what it copies */
+  if ((crc32c_copy(&set[1], &set[2051], 2000, 0) != crc) ||
+      (my_memcmp(&set[1], &set[2051], 2000) != 0))
+  {
+    ret = TEST_ERROR;
+  }
+
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_dma()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  dma_engine_t * engine;
+  dma_desc_t desc;
+  dma_ticket_t tickets[3];
+  dma_completion_t done;
+
+  PRINTF("test_dma()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  engine = dma_create(NULL);
+  if ((! set ) || (! engine ))
+  {
+    free_words( (uint32_t*)set );
+    dma_destroy(engine);
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)(i * 7);
+  }
+
+  /* Fill, then copy the filled bytes on, then copy those back over the
+     start; each step depends on the one before running first */
+  desc.op = DMA_OP_SET;
+  desc.src = NULL;
+  desc.dst = &set[1000];
+  desc.length = 1000;
+  desc.value = 0x5A;
+  desc.user = &tickets[0];
+  tickets[0] = dma_submit(engine, &desc);
+
+  desc.op = DMA_OP_COPY;
+  desc.src = &set[1000];
+  desc.dst = &set[3001];
+  desc.user = &tickets[1];
+  tickets[1] = dma_submit(engine, &desc);
+
+  desc.src = &set[3001];
+  desc.dst = &set[1];
+  desc.length = 500;
+  desc.user = &tickets[2];
+  tickets[2] = dma_submit(engine, &desc);
+
+  dma_wait(engine, tickets[2]);
+  if (! dma_poll(engine, tickets[0]))
+  {
+    ret = TEST_ERROR;
+  }
+  for (i = 0; i < 500; i++)
+  {
+    if ((set[1 + i] != 0x5A) || (set[3001 + i] != 0x5A))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if ((set[0] != 0) || (set[501] != (uint8_t)(501 * 7)) ||
+      (set[4001] != (uint8_t)(4001 * 7)))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Completions come back in submission order with their user data */
+  for (i = 0; i < 3; i++)
+  {
+    if ((! dma_reap(engine, &done)) || (done.ticket != tickets[i]) ||
+        (done.user != &tickets[i]))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if (dma_reap(engine, &done))
+  {
+    ret = TEST_ERROR;
+  }
+
+  dma_destroy(engine);
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_buffer()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint8_t * bytes;
+  const uint8_t * shared;
+  buffer_view_t whole;
+  buffer_view_t copy;
+  buffer_view_t slice;
+
+  PRINTF("test_buffer()\n");
+  set = (uint8_t*)reserve_words(MEM_SET_SIZE_W);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_SET_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)i;
+  }
+
+  whole = buffer_from(set, MEM_SET_SIZE_B);
+  free_words( (uint32_t*)set );
+  if (! buffer_data(whole) )
+  {
+    return TEST_ERROR;
+  }
+
+  /* Three views of one buffer, the slice starting at byte 8 */
+  copy = buffer_share(whole);
+  slice = buffer_slice(whole, 8, 16);
+  shared = buffer_data(whole);
+  if ((buffer_refs(whole) != 3) || (buffer_data(copy) != shared) ||
+      (buffer_data(slice) != shared + 8) || (buffer_data(slice)[0] != 8) ||
+      (buffer_slice(whole, 20, 16).buffer != NULL))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* Writing the shared slice copies its range away from the others */
+  bytes = buffer_mutable(&slice);
+  if ((! bytes ) || (bytes == shared + 8) || (buffer_refs(slice) != 1) ||
+      (buffer_refs(whole) != 2) || (slice.length != 16))
+  {
+    ret = TEST_ERROR;
+  }
+  else
+  {
+    bytes[0] = 0xFF;
+    if ((shared[8] != 8) || (bytes[15] != 23))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  /* The last view of a buffer is written in place */
+  buffer_release(&copy);
+  if ((copy.buffer != NULL) || (buffer_mutable(&whole) != shared))
+  {
+    ret = TEST_ERROR;
+  }
+
+  buffer_release(&slice);
+  buffer_release(&whole);
+  return ret;
+}
+
+int8_t test_ring()
+{
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint8_t value;
+  ring_t * ring;
+  ring_t * placed;
+
+  PRINTF("test_ring()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  ring = ring_create(RING_CAPACITY);
+  if ((! set ) || (! ring ))
+  {
+    free_words( (uint32_t*)set );
+    ring_destroy(ring);
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_SET_SIZE_B; i++)
+  {
+    set[i] = (uint8_t)i;
+  }
+
+  /* The capacity rounds up to 16, the second write wraps and the third
+     only has room for 2 of its bytes */
+  if ((ring_capacity(ring) != 16) || (ring_write(ring, set, 10) != 10) ||
+      (ring_read(ring, &set[MEM_SET_SIZE_B], 6) != 6) ||
+      (ring_write(ring, &set[10], 10) != 10) ||
+      (ring_write(ring, &set[20], 5) != 2) ||
+      (ring_used(ring) != 16) || (ring_put(ring, 0xFF)))
+  {
+    ret = TEST_ERROR;
+  }
+  if ((ring_read(ring, &set[MEM_SET_SIZE_B + 6], MEM_SET_SIZE_B) != 16) ||
+      (ring_get(ring, &value)))
+  {
+    ret = TEST_ERROR;
+  }
+  for( i = 0; i < 22; i++)
+  {
+    if (set[MEM_SET_SIZE_B + i] != i)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if ((! ring_put(ring, 0xA5)) || (! ring_get(ring, &value)) ||
+      (value != 0xA5) || (ring_used(ring) != 0))
+  {
+    ret = TEST_ERROR;
+  }
+  ring_destroy(ring);
+
+  /* A ring in caller memory stores its bookkeeping and a power of two of
+     storage inside the buffer */
+  placed = ring_init(set, MEM_LARGE_SIZE_B);
+  if ((! placed ) ||
+      ((ring_capacity(placed) & (ring_capacity(placed) - 1)) != 0) ||
+      ((ring_capacity(placed) * 2) <= (MEM_LARGE_SIZE_B - sizeof(ring_t))) ||
+      ((placed->data + ring_capacity(placed)) > (set + MEM_LARGE_SIZE_B)))
+  {
+    ret = TEST_ERROR;
+  }
+  ring_destroy(placed);
+
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_mpmc()
+{
+  size_t i;
+  size_t lap;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  void * item;
+  mpmc_t * queue;
+
+  PRINTF("test_mpmc()\n");
+  set = (uint8_t*)reserve_words(MEM_SET_SIZE_W);
+  queue = mpmc_create(MPMC_CAPACITY);
+  if ((! set ) || (! queue ))
+  {
+    free_words( (uint32_t*)set );
+    mpmc_destroy(queue);
+    return TEST_ERROR;
+  }
+
+  /* The capacity rounds up to 8; each lap moves the slots on by 8 */
+  if ((mpmc_capacity(queue) != 8) || (mpmc_pop(queue, &item)))
+  {
+    ret = TEST_ERROR;
+  }
+  for (lap = 0; lap < 3; lap++)
+  {
+    for (i = 0; i < 8; i++)
+    {
+      if (! mpmc_push(queue, &set[i + lap]))
+      {
+        ret = TEST_ERROR;
+      }
+    }
+    if (mpmc_push(queue, set))
+    {
+      ret = TEST_ERROR;
+    }
+    for (i = 0; i < 8; i++)
+    {
+      if ((! mpmc_pop(queue, &item)) || (item != &set[i + lap]))
+      {
+        ret = TEST_ERROR;
+      }
+    }
+    if (mpmc_pop(queue, &item))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  /* Interleaved pushes and pops keep their order across the wrap */
+  for (i = 0; i < MEM_SET_SIZE_B; i++)
+  {
+    if ((! mpmc_push(queue, &set[i])) ||
+        ((i % 2 == 1) && ((! mpmc_pop(queue, &item)) ||
+                          (item != &set[i - 1]) ||
+                          (! mpmc_pop(queue, &item)) ||
+                          (item != &set[i]))))
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  mpmc_destroy(queue);
+  free_words( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_memstream()
+{
+  static const size_t offsets[] = {1, 3, 15};
+  static const size_t lengths[] = {1, 17, 1997};
+  size_t i;
+  size_t o;
+  size_t l;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint8_t * dst;
+
+  PRINTF("test_memstream()\n");
+  set = (uint8_t*)reserve_aligned(MEM_LARGE_SIZE_W, MEM_STREAM_ALIGN);
+  if (! set )
+  {
+    return TEST_ERROR;
+  }
+
+  for (o = 0; o < 3; o++)
+  {
+    for (l = 0; l < 3; l++)
+    {
+      /* Source in the lower half, destination in the upper half with
+         guard bytes all around it */
+      for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+      {
+        set[i] = (i < (MEM_LARGE_SIZE_B / 2)) ? (uint8_t)(i * 7) : 0xEE;
+      }
+      dst = &set[(MEM_LARGE_SIZE_B / 2) + offsets[o]];
+      my_memcopy_stream(&set[offsets[l]], dst, lengths[l], MEM_STREAM_ALWAYS);
+      for (i = MEM_LARGE_SIZE_B / 2; i < MEM_LARGE_SIZE_B; i++)
+      {
+        if ((&set[i] >= dst) && (&set[i] < dst + lengths[l]))
+        {
+          if (set[i] != (uint8_t)((offsets[l] + (size_t)(&set[i] - dst)) * 7))
+          {
+            ret = TEST_ERROR;
+          }
+        }
+        else if (set[i] != 0xEE)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+
+      my_memset_stream(dst, lengths[l], 0x5A, MEM_STREAM_ALWAYS);
+      for (i = MEM_LARGE_SIZE_B / 2; i < MEM_LARGE_SIZE_B; i++)
+      {
+        if ((&set[i] >= dst) && (&set[i] < dst + lengths[l]))
+        {
+          if (set[i] != 0x5A)
+          {
+            ret = TEST_ERROR;
+          }
+        }
+        else if (set[i] != 0xEE)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+    }
+  }
+
+  free_aligned( (uint32_t*)set );
+  return ret;
+}
+
+int8_t test_memparallel()
+{
+#if defined (HOST)
+  static const unsigned int threads[] = {1, 3, 64};
+  size_t i;
+  size_t t;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * src;
+  uint8_t * ref;
+  uint8_t * dst;
+
+  PRINTF("test_memparallel()\n");
+  src = (uint8_t*)reserve_words(MEM_PARALLEL_SIZE_W);
+  ref = (uint8_t*)reserve_words(MEM_PARALLEL_SIZE_W);
+  dst = (uint8_t*)reserve_words(MEM_PARALLEL_SIZE_W);
+  if ((! src ) || (! ref ) || (! dst ))
+  {
+    free_words( (uint32_t*)src );
+    free_words( (uint32_t*)ref );
+    free_words( (uint32_t*)dst );
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_PARALLEL_SIZE_B + 1; i++)
+  {
+    src[i] = (uint8_t)((i * 7) ^ (i >> 11));
+  }
+
+  for (t = 0; t < 3; t++)
+  {
+    /* The source starts one byte in so no slice is word aligned */
+    my_memset(ref, MEM_PARALLEL_SIZE_B + 1, 0xEE);
+    my_memset(dst, MEM_PARALLEL_SIZE_B + 1, 0xEE);
+    my_memcopy(&src[1], ref, MEM_PARALLEL_SIZE_B);
+    my_memcopy_parallel(&src[1], dst, MEM_PARALLEL_SIZE_B, threads[t]);
+    if (my_memcmp(ref, dst, MEM_PARALLEL_SIZE_B + 1) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+
+    my_memset(&ref[1], MEM_PARALLEL_SIZE_B - 1, (uint8_t)(0x50 + t));
+    my_memset_parallel(&dst[1], MEM_PARALLEL_SIZE_B - 1, (uint8_t)(0x50 + t),
+                       threads[t]);
+    if (my_memcmp(ref, dst, MEM_PARALLEL_SIZE_B + 1) != 0)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  free_words( (uint32_t*)src );
+  free_words( (uint32_t*)ref );
+  free_words( (uint32_t*)dst );
+  return ret;
+#else
+  /* MEM_PARALLEL_CUTOFF is far larger than the MSP432's RAM */
+  return TEST_NO_ERROR;
+#endif
+}
+
+int8_t test_elements()
+{
+  static const size_t widths[] = {1, 2, 4, 8};
+  static const size_t counts[] = {0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33,
+                                  63, 64, 65, 127, 129, 255};
+  size_t i;
+  size_t w;
+  size_t c;
+  size_t e;
+  size_t b;
+  size_t width;
+  size_t count;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint8_t * ref;
+  uint8_t * src;
+  uint8_t * dst;
+
+  PRINTF("test_elements()\n");
+  set = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  ref = (uint8_t*)reserve_words(MEM_LARGE_SIZE_W);
+  if ((! set ) || (! ref ))
+  {
+    free_words( (uint32_t*)set );
+    free_words( (uint32_t*)ref );
+    return TEST_ERROR;
+  }
+  src = &set[1];
+  dst = &set[(MEM_LARGE_SIZE_B / 2) + 3];
+
+  /* Byte lengths run either side of the 16, 32 and 64 byte blocks of the
+     vector kernels for every width */
+  for (w = 0; w < sizeof(widths) / sizeof(size_t); w++)
+  {
+    for (c = 0; c < sizeof(counts) / sizeof(size_t); c++)
+    {
+      width = widths[w];
+      count = counts[c];
+
+      /* Reverse in place: element e comes from element count - 1 - e */
+      for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+      {
+        set[i] = (uint8_t)((i * 7) ^ (i >> 8));
+        ref[i] = set[i];
+      }
+      for (e = 0; e < count; e++)
+      {
+        for (b = 0; b < width; b++)
+        {
+          ref[1 + (e * width) + b] = src[((count - 1 - e) * width) + b];
+        }
+      }
+      my_reverse_elements(src, count, width);
+      if (test_bytes_equal(set, ref, MEM_LARGE_SIZE_B) != TEST_NO_ERROR)
+      {
+        ret = TEST_ERROR;
+      }
+
+      /* Swap between buffers: byte b comes from byte width - 1 - b */
+      for( i = 0; i < MEM_LARGE_SIZE_B; i++)
+      {
+        set[i] = (uint8_t)((i * 7) ^ (i >> 8));
+        ref[i] = set[i];
+      }
+      for (e = 0; e < count; e++)
+      {
+        for (b = 0; b < width; b++)
+        {
+          ref[(dst - set) + (e * width) + b] =
+            src[(e * width) + (width - 1 - b)];
+        }
+      }
+      my_byteswap(src, dst, count, width);
+      if (test_bytes_equal(set, ref, MEM_LARGE_SIZE_B) != TEST_NO_ERROR)
+      {
+        ret = TEST_ERROR;
+      }
+
+      /* Swap in place, which must give the same bytes */
+      for( i = 0; i < count * width; i++)
+      {
+        ref[1 + i] = ref[(dst - set) + i];
+      }
+      my_byteswap(src, src, count, width);
+      if (test_bytes_equal(set, ref, MEM_LARGE_SIZE_B) != TEST_NO_ERROR)
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+
+  free_words( (uint32_t*)set );
+  free_words( (uint32_t*)ref );
+  return ret;
+}
+
+int8_t test_memstats()
+{
+#if defined (MEM_STATS)
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+  uint32_t * before;
+  uint32_t * after;
+  mem_stats_t snap;
+  size_t live;
+
+  PRINTF("test_memstats()\n");
+  before = (uint32_t*)reserve_words(MEM_SET_SIZE_W);
+  if (! before )
+  {
+    return TEST_ERROR;
+  }
+
+  mem_stats_reset();
+  mem_stats_snapshot(&snap);
+  live = snap.live_bytes;
+  if ((snap.allocs != 0) || (snap.frees != 0) ||
+      (live < MEM_SET_SIZE_B) || (snap.peak_bytes != live))
+  {
+    ret = TEST_ERROR;
+  }
+
+  /* One block from each side of the reset */
+  after = (uint32_t*)reserve_words(MEM_SET_SIZE_W / 2);
+  free_words(before);
+  free_words(after);
+  mem_stats_snapshot(&snap);
+  if ((! after ) || (snap.allocs != 1) || (snap.frees != 2) ||
+      (snap.live_bytes != live - MEM_SET_SIZE_B) ||
+      (snap.peak_bytes != live + (MEM_SET_SIZE_B / 2)))
+  {
+    ret = TEST_ERROR;
+  }
+  for (i = 0; i < MEM_STATS_SITES; i++)
+  {
+    if (snap.sites[i].live_bytes > snap.live_bytes)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+
+  return ret;
+#else
+  return TEST_NO_ERROR;
+#endif
+}
+
+#if defined (HOST)
+/**
+ * @brief Work of one test_pool_threads() thread.
+ */
+typedef struct {
+  void * blocks[POOL_TEST_BLOCKS];  /* Blocks left for the caller to free */
+  int frees;                        /* Non-zero to free every other block */
+} test_pool_work_t;
+
+/**
+ * @brief Allocates POOL_TEST_BLOCKS blocks and may free every other one.
+ *
+ * @param arg Pointer to the thread's test_pool_work_t.
+ *
+ * @return Null Pointer.
+ */
+static void * test_pool_worker(void * arg)
+{
+  test_pool_work_t * work = (test_pool_work_t *)arg;
+  size_t i;
+
+  for (i = 0; i < POOL_TEST_BLOCKS; i++)
+  {
+    work->blocks[i] = pool_alloc(POOL_TEST_SIZE);
+  }
+  for (i = 0; work->frees && (i < POOL_TEST_BLOCKS); i += 2)
+  {
+    pool_free(work->blocks[i]);
+    work->blocks[i] = NULL;
+  }
+  return NULL;
+}
+#endif
+
+int8_t test_pool_threads()
+{
+#if defined (HOST)
+  static test_pool_work_t work[POOL_TEST_THREADS];
+  pthread_t threads[POOL_TEST_THREADS];
+  pool_class_stats_t stats;
+  size_t i;
+  size_t t;
+  int8_t ret = TEST_NO_ERROR;
+
+  PRINTF("test_pool_threads()\n");
+  /* Half the threads never free, so only their allocations can register
+     their caches for the exit drain */
+  for (t = 0; t < POOL_TEST_THREADS; t++)
+  {
+    work[t].frees = (int)(t % 2);
+    if (pthread_create(&threads[t], NULL, test_pool_worker, &work[t]) != 0)
+    {
+      while (t > 0)
+      {
+        pthread_join(threads[--t], NULL);
+      }
+      return TEST_ERROR;
+    }
+  }
+  for (t = 0; t < POOL_TEST_THREADS; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+
+  /* Every thread exited holding a partly used cache batch */
+  for (t = 0; t < POOL_TEST_THREADS; t++)
+  {
+    for (i = 0; i < POOL_TEST_BLOCKS; i++)
+    {
+      if (((i % 2 == 1) || (! work[t].frees )) && (! work[t].blocks[i] ))
+      {
+        ret = TEST_ERROR;
+      }
+      pool_free(work[t].blocks[i]);
+    }
+  }
+
+  pool_class_stats(POOL_TEST_SIZE, &stats);
+  if ((stats.carved == 0) || (stats.carved != stats.depot + stats.cached))
+  {
+    ret = TEST_ERROR;
+  }
+  return ret;
+#else
+  return TEST_NO_ERROR;
+#endif
+}
+
+int8_t test_pool_huge()
+{
+#if defined (HOST)
+  static const pool_huge_t modes[] = {POOL_HUGE_TRANSPARENT, POOL_HUGE_EXPLICIT};
+  size_t m;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * block;
+  pool_backing_t backing;
+
+  PRINTF("test_pool_huge()\n");
+  for (m = 0; m < 2; m++)
+  {
+    pool_set_huge_mode(modes[m], POOL_HUGE_TEST_THRESHOLD);
+    block = (uint8_t*)pool_alloc_aligned(POOL_HUGE_TEST_SIZE, MEM_STREAM_ALIGN);
+    if (! block )
+    {
+      ret = TEST_ERROR;
+      continue;
+    }
+
+    /* A block without huge pages falls back to the heap, never a slab */
+    backing = pool_backing(block);
+    #ifdef VERBOSE
+    PRINTF("  Backing: %s\n", pool_backing_name(backing));
+    #endif
+    if (((backing != POOL_BACKING_THP) && (backing != POOL_BACKING_HUGETLB) &&
+         (backing != POOL_BACKING_HEAP)) ||
+        (pool_size(block) != POOL_HUGE_TEST_SIZE) ||
+        (((uintptr_t)block & (MEM_STREAM_ALIGN - 1)) != 0))
+    {
+      ret = TEST_ERROR;
+    }
+
+    my_memset(block, POOL_HUGE_TEST_SIZE, (uint8_t)(0xA0 + m));
+    if ((block[0] != (uint8_t)(0xA0 + m)) ||
+        (block[POOL_HUGE_TEST_SIZE - 1] != (uint8_t)(0xA0 + m)))
+    {
+      ret = TEST_ERROR;
+    }
+    pool_free(block);
+  }
+
+  pool_set_huge_mode(POOL_HUGE_MODE, POOL_HUGE_THRESHOLD);
+  return ret;
+#else
+  /* Huge pages are a Linux host feature */
+  return TEST_NO_ERROR;
+#endif
+}
+
+#if defined (HOST)
+/**
+ * @brief Writes RING_THREAD_BYTES of a counting sequence into a ring.
+ *
+ * Chunk lengths vary so writes straddle the end of the storage at every
+ * offset, and every eighth chunk goes through ring_put() one byte at a time.
+ *
+ * @param arg Pointer to the ring.
+ *
+ * @return Null Pointer.
+ */
+static void * test_ring_producer(void * arg)
+{
+  ring_t * ring = (ring_t *)arg;
+  uint8_t chunk[RING_THREAD_CHUNK];
+  size_t sent = 0;
+  size_t length;
+  size_t done;
+  size_t n = 0;
+  size_t i;
+
+  while (sent < RING_THREAD_BYTES)
+  {
+    length = (n % RING_THREAD_CHUNK) + 1;
+    if (length > RING_THREAD_BYTES - sent)
+    {
+      length = RING_THREAD_BYTES - sent;
+    }
+    for (i = 0; i < length; i++)
+    {
+      chunk[i] = (uint8_t)(sent + i);
+    }
+    for (done = 0; done < length; )
+    {
+      if ((n % 8) == 7)
+      {
+        i = (size_t)ring_put(ring, chunk[done]);
+      }
+      else
+      {
+        i = ring_write(ring, &chunk[done], length - done);
+      }
+      if (i == 0)
+      {
+        sched_yield();
+      }
+      done += i;
+    }
+    sent += length;
+    n++;
+  }
+  return NULL;
+}
+#endif
+
+int8_t test_ring_threads()
+{
+#if defined (HOST)
+  uint8_t chunk[RING_THREAD_CHUNK];
+  pthread_t producer;
+  ring_t * ring;
+  size_t received = 0;
+  size_t length;
+  size_t n = 0;
+  size_t i;
+  int8_t ret = TEST_NO_ERROR;
+
+  PRINTF("test_ring_threads()\n");
+  ring = ring_create(RING_THREAD_CAPACITY);
+  if (! ring )
+  {
+    return TEST_ERROR;
+  }
+  if (pthread_create(&producer, NULL, test_ring_producer, ring) != 0)
+  {
+    ring_destroy(ring);
+    return TEST_ERROR;
+  }
+
+  /* Read lengths cycle out of step with the producer's chunks */
+  while (received < RING_THREAD_BYTES)
+  {
+    if ((n % 5) == 4)
+    {
+      length = (size_t)ring_get(ring, chunk);
+    }
+    else
+    {
+      length = ring_read(ring, chunk, (n % (RING_THREAD_CHUNK - 4)) + 1);
+    }
+    if (length == 0)
+    {
+      sched_yield();
+    }
+    for (i = 0; i < length; i++)
+    {
+      if (chunk[i] != (uint8_t)(received + i))
+      {
+        ret = TEST_ERROR;
+      }
+    }
+    received += length;
+    n++;
+  }
+
+  pthread_join(producer, NULL);
+  if ((received != RING_THREAD_BYTES) || (ring_used(ring) != 0))
+  {
+    ret = TEST_ERROR;
+  }
+  ring_destroy(ring);
+  return ret;
+#else
+  return TEST_NO_ERROR;
+#endif
+}
+
+#if defined (HOST)
+/**
+ * @brief Work of one test_mpmc_threads() thread.
+ */
+typedef struct {
+  mpmc_t * queue;    /* Queue shared by every thread */
+  size_t first;      /* Producers push first + 1 to first + MPMC_THREAD_ITEMS */
+  size_t * popped;   /* Items popped by all consumers so far */
+  uint8_t * seen;    /* Times each item was popped, indexed by item - 1 */
+  uint64_t sum;      /* Sum of the items a consumer popped */
+} test_mpmc_work_t;
+
+/**
+ * @brief Pushes MPMC_THREAD_ITEMS consecutive items, as pointers.
+ *
+ * Gives up early if the run is abandoned by marking every item popped.
+ *
+ * @param arg Pointer to the thread's test_mpmc_work_t.
+ *
+ * @return Null Pointer.
+ */
+static void * test_mpmc_producer(void * arg)
+{
+  test_mpmc_work_t * work = (test_mpmc_work_t *)arg;
+  size_t item;
+
+  for (item = work->first + 1; item <= work->first + MPMC_THREAD_ITEMS; item++)
+  {
+    while (! mpmc_push(work->queue, (void *)(uintptr_t)item))
+    {
+      if (__atomic_load_n(work->popped, __ATOMIC_RELAXED) >=
+          (MPMC_THREAD_PAIRS * MPMC_THREAD_ITEMS))
+      {
+        return NULL;
+      }
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Pops and sums items until every producer's items have been popped.
+ *
+ * @param arg Pointer to the thread's test_mpmc_work_t.
+ *
+ * @return Null Pointer.
+ */
+static void * test_mpmc_consumer(void * arg)
+{
+  test_mpmc_work_t * work = (test_mpmc_work_t *)arg;
+  void * item;
+
+  while (__atomic_load_n(work->popped, __ATOMIC_RELAXED) <
+         (MPMC_THREAD_PAIRS * MPMC_THREAD_ITEMS))
+  {
+    if (mpmc_pop(work->queue, &item))
+    {
+      work->sum += (uintptr_t)item;
+      __atomic_fetch_add(&work->seen[(uintptr_t)item - 1], 1, __ATOMIC_RELAXED);
+      __atomic_fetch_add(work->popped, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+#endif
+
+int8_t test_mpmc_threads()
+{
+#if defined (HOST)
+  static uint8_t seen[MPMC_THREAD_PAIRS * MPMC_THREAD_ITEMS];
+  test_mpmc_work_t work[2 * MPMC_THREAD_PAIRS];
+  pthread_t threads[2 * MPMC_THREAD_PAIRS];
+  uint64_t items = (uint64_t)MPMC_THREAD_PAIRS * MPMC_THREAD_ITEMS;
+  uint64_t sum = 0;
+  size_t popped = 0;
+  size_t started;
+  size_t t;
+  mpmc_t * queue;
+  void * item;
+  int8_t ret = TEST_NO_ERROR;
+
+  PRINTF("test_mpmc_threads()\n");
+  queue = mpmc_create(MPMC_CAPACITY);
+  if (! queue )
+  {
+    return TEST_ERROR;
+  }
+  my_memzero(seen, sizeof(seen));
+
+  /* Producers take the even entries and consumers the odd ones */
+  for (started = 0; started < 2 * MPMC_THREAD_PAIRS; started++)
+  {
+    work[started].queue = queue;
+    work[started].first = (started / 2) * MPMC_THREAD_ITEMS;
+    work[started].popped = &popped;
+    work[started].seen = seen;
+    work[started].sum = 0;
+    if (pthread_create(&threads[started], NULL,
+                       (started % 2) ? test_mpmc_consumer : test_mpmc_producer,
+                       &work[started]) != 0)
+    {
+      ret = TEST_ERROR;
+      break;
+    }
+  }
+  if (ret != TEST_NO_ERROR)
+  {
+    /* Abandon the run so the threads already started return */
+    __atomic_store_n(&popped, (size_t)items, __ATOMIC_RELAXED);
+  }
+  for (t = 0; t < started; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+  if (ret != TEST_NO_ERROR)
+  {
+    mpmc_destroy(queue);
+    return ret;
+  }
+
+  for (t = 1; t < 2 * MPMC_THREAD_PAIRS; t += 2)
+  {
+    sum += work[t].sum;
+  }
+  for (t = 0; t < items; t++)
+  {
+    if (seen[t] != 1)
+    {
+      ret = TEST_ERROR;
+    }
+  }
+  if ((popped != items) || (sum != (items * (items + 1)) / 2) ||
+      mpmc_pop(queue, &item))
+  {
+    ret = TEST_ERROR;
+  }
+  mpmc_destroy(queue);
+  return ret;
+#else
+  return TEST_NO_ERROR;
+#endif
+}
+
+/* Lengths around the word, vector block and streaming threshold sizes */
+static const size_t test_align_lengths[] = {
+  0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129,
+  MEM_ALIGN_TEST_STREAM - 1, MEM_ALIGN_TEST_STREAM, MEM_ALIGN_TEST_STREAM + 1,
+  MEM_ALIGN_TEST_STREAM + 71
+};
+
+int8_t test_memcopy_align()
+{
+  size_t threshold = my_mem_stream_threshold();
+  size_t i;
+  size_t s;
+  size_t d;
+  size_t l;
+  size_t length;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * src;
+  uint8_t * dst;
+  uint8_t * ref;
+
+  PRINTF("test_memcopy_align()\n");
+  src = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  dst = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  ref = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  if ((! src ) || (! dst ) || (! ref ))
+  {
+    free_aligned( (uint32_t*)src );
+    free_aligned( (uint32_t*)dst );
+    free_aligned( (uint32_t*)ref );
+    return TEST_ERROR;
+  }
+  for( i = 0; i < MEM_ALIGN_TEST_SIZE_B; i++)
+  {
+    src[i] = (uint8_t)((i * 7) ^ (i >> 8));
+  }
+
+  /* A small threshold puts the streaming switch inside the sweep */
+  my_mem_set_stream_threshold(MEM_ALIGN_TEST_STREAM);
+  for (s = 0; s < MEM_ALIGN_TEST_OFFSETS; s++)
+  {
+    for (d = 0; d < MEM_ALIGN_TEST_OFFSETS; d++)
+    {
+      for (l = 0; l < sizeof(test_align_lengths) / sizeof(size_t); l++)
+      {
+        length = test_align_lengths[l];
+        for( i = 0; i < MEM_ALIGN_TEST_SIZE_B; i++)
+        {
+          dst[i] = 0xEE;
+          ref[i] = 0xEE;
+        }
+        for( i = 0; i < length; i++)
+        {
+          ref[d + i] = src[s + i];
+        }
+        my_memcopy(&src[s], &dst[d], length);
+        if (test_bytes_equal(dst, ref, MEM_ALIGN_TEST_SIZE_B) != TEST_NO_ERROR)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+    }
+  }
+  my_mem_set_stream_threshold(threshold);
+
+  free_aligned( (uint32_t*)src );
+  free_aligned( (uint32_t*)dst );
+  free_aligned( (uint32_t*)ref );
+  return ret;
+}
+
+#if defined (HOST)
+/**
+ * @brief Maps one page of data between two inaccessible guard pages.
+ *
+ * @param page Page size in bytes.
+ *
+ * @return Pointer to the data page, or a Null Pointer on failure.
+ */
+static uint8_t * test_guard_map(size_t page)
+{
+  uint8_t * map;
+
+  map = (uint8_t *)mmap(NULL, 3 * page, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map == (uint8_t *)MAP_FAILED)
+  {
+    return NULL;
+  }
+  if ((mprotect(map, page, PROT_NONE) != 0) ||
+      (mprotect(map + (2 * page), page, PROT_NONE) != 0))
+  {
+    munmap(map, 3 * page);
+    return NULL;
+  }
+  return map + page;
+}
+
+/**
+ * @brief Unmaps a page mapped by test_guard_map() with its guard pages.
+ *
+ * @param data Pointer to the data page.
+ * @param page Page size in bytes.
+ *
+ * @return void
+ */
+static void test_guard_unmap(uint8_t * data, size_t page)
+{
+  munmap(data - page, 3 * page);
+}
+#endif
+
+int8_t test_memcopy_guard()
+{
+#if defined (HOST)
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t lengths[MEM_GUARD_TEST_LENGTHS];
+  size_t i;
+  size_t o;
+  size_t d;
+  size_t l;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * data;
+  uint8_t * src;
+  uint8_t * exact;
+  uint8_t * dst;
+
+  PRINTF("test_memcopy_guard()\n");
+  data = test_guard_map(page);
+  dst = (uint8_t *)malloc(page + MEM_ALIGN_TEST_OFFSETS);
+  if ((! data ) || (! dst ))
+  {
+    if (data)
+    {
+      test_guard_unmap(data, page);
+    }
+    free(dst);
+    return TEST_ERROR;
+  }
+  for( i = 0; i < page; i++)
+  {
+    data[i] = (uint8_t)((i * 7) ^ (i >> 8));
+  }
+
+  for (o = 1; o < MEM_ALIGN_TEST_OFFSETS; o++)
+  {
+    /* Each length puts the first source byte o bytes past a word boundary;
+       the longest source starts just after the leading guard page */
+    lengths[0] = MEM_ALIGN_TEST_OFFSETS - o;
+    lengths[1] = (3 * MEM_ALIGN_TEST_OFFSETS) - o;
+    lengths[2] = (9 * MEM_ALIGN_TEST_OFFSETS) - o;
+    lengths[3] = (17 * MEM_ALIGN_TEST_OFFSETS) - o;
+    lengths[4] = page - o;
+    for (l = 0; l < MEM_GUARD_TEST_LENGTHS; l++)
+    {
+      src = data + page - lengths[l];
+      for (d = 0; d < MEM_ALIGN_TEST_OFFSETS; d++)
+      {
+        my_memcopy(src, &dst[d], lengths[l]);
+        if (test_bytes_equal(&dst[d], src, lengths[l]) != TEST_NO_ERROR)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+    }
+
+    /* A page boundary is word aligned, so sources that also end part way
+       into a word come from heap blocks sized to end with them */
+    for (l = 1; l <= MEM_GUARD_TEST_REDZONE; l++)
+    {
+      exact = (uint8_t *)malloc(o + l);
+      if (! exact )
+      {
+        ret = TEST_ERROR;
+        continue;
+      }
+      for( i = 0; i < o + l; i++)
+      {
+        exact[i] = data[i];
+      }
+      for (d = 0; d < MEM_ALIGN_TEST_OFFSETS; d++)
+      {
+        my_memcopy(&exact[o], &dst[d], l);
+        if (test_bytes_equal(&dst[d], &data[o], l) != TEST_NO_ERROR)
+        {
+          ret = TEST_ERROR;
+        }
+      }
+      free(exact);
+    }
+  }
+
+  test_guard_unmap(data, page);
+  free(dst);
+  return ret;
+#else
+  return TEST_NO_ERROR;
+#endif
+}
+
+/**
+ * @brief Moves bytes within a buffer and checks all of it.
+ *
+ * The buffer is refilled with a pattern and the expected result is built
+ * one byte at a time in a second buffer of the same size.
+ *
+ * @param buffer Pointer to the buffer to move within.
+ * @param ref Pointer to the buffer for the expected result.
+ * @param size Length of bytes of each buffer.
+ * @param from Offset of the source in the buffer.
+ * @param to Offset of the destination in the buffer.
+ * @param length Length of bytes to move.
+ *
+ * @return TEST_NO_ERROR if the buffers match, TEST_ERROR otherwise.
+ */
+static int8_t test_move_check(uint8_t * buffer, uint8_t * ref, size_t size,
+                              size_t from, size_t to, size_t length)
+{
+  size_t i;
+
+  for( i = 0; i < size; i++)
+  {
+    buffer[i] = (uint8_t)((i * 7) ^ (i >> 8));
+    ref[i] = buffer[i];
+  }
+  for( i = 0; i < length; i++)
+  {
+    ref[to + i] = buffer[from + i];
+  }
+  my_memmove(&buffer[from], &buffer[to], length);
+  return test_bytes_equal(buffer, ref, size);
+}
+
+int8_t test_memmove_align()
+{
+  static const size_t shifts[] = {0, 2 * MEM_ALIGN_TEST_OFFSETS,
+                                  4 * MEM_ALIGN_TEST_OFFSETS};
+  size_t threshold = my_mem_stream_threshold();
+  size_t s;
+  size_t d;
+  size_t k;
+  size_t l;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint8_t * ref;
+
+  PRINTF("test_memmove_align()\n");
+  set = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  ref = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  if ((! set ) || (! ref ))
+  {
+    free_aligned( (uint32_t*)set );
+    free_aligned( (uint32_t*)ref );
+    return TEST_ERROR;
+  }
+
+  /* The source sits in the middle shift, so the destination lands below,
+     inside and above it */
+  my_mem_set_stream_threshold(MEM_ALIGN_TEST_STREAM);
+  for (s = 0; s < MEM_ALIGN_TEST_OFFSETS; s++)
+  {
+    for (d = 0; d < MEM_ALIGN_TEST_OFFSETS; d++)
+    {
+      for (k = 0; k < sizeof(shifts) / sizeof(size_t); k++)
+      {
+        for (l = 0; l < sizeof(test_align_lengths) / sizeof(size_t); l++)
+        {
+          if (test_move_check(set, ref, MEM_ALIGN_TEST_SIZE_B, shifts[1] + s,
+                              shifts[k] + d, test_align_lengths[l]) !=
+              TEST_NO_ERROR)
+          {
+            ret = TEST_ERROR;
+          }
+        }
+      }
+    }
+  }
+  my_mem_set_stream_threshold(threshold);
+
+  free_aligned( (uint32_t*)set );
+  free_aligned( (uint32_t*)ref );
+  return ret;
+}
+
+int8_t test_memmove_guard()
+{
+#if defined (HOST)
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t lengths[MEM_GUARD_TEST_LENGTHS];
+  size_t o;
+  size_t k;
+  size_t l;
+  size_t size;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * data;
+  uint8_t * ref;
+  uint8_t * exact;
+
+  PRINTF("test_memmove_guard()\n");
+  data = test_guard_map(page);
+  ref = (uint8_t *)malloc(page);
+  if ((! data ) || (! ref ))
+  {
+    if (data)
+    {
+      test_guard_unmap(data, page);
+    }
+    free(ref);
+    return TEST_ERROR;
+  }
+
+  for (o = 1; o < MEM_ALIGN_TEST_OFFSETS; o++)
+  {
+    lengths[0] = MEM_ALIGN_TEST_OFFSETS - o;
+    lengths[1] = (3 * MEM_ALIGN_TEST_OFFSETS) - o;
+    lengths[2] = (9 * MEM_ALIGN_TEST_OFFSETS) - o;
+    lengths[3] = (17 * MEM_ALIGN_TEST_OFFSETS) - o;
+    lengths[4] = page - (2 * MEM_ALIGN_TEST_OFFSETS) - o;
+    for (k = 1; k < MEM_ALIGN_TEST_OFFSETS; k++)
+    {
+      for (l = 0; l < MEM_GUARD_TEST_LENGTHS; l++)
+      {
+        /* Down from the trailing guard page, and up from o bytes past the
+           leading one */
+        if ((test_move_check(data, ref, page, page - lengths[l],
+                             page - lengths[l] - k, lengths[l]) !=
+             TEST_NO_ERROR) ||
+            (test_move_check(data, ref, page, o, o + k, lengths[l]) !=
+             TEST_NO_ERROR))
+        {
+          ret = TEST_ERROR;
+        }
+      }
+
+      /* Heap blocks ending with the source moved down, or with the
+         destination of a source o bytes into the block moved up */
+      for (l = 1; l <= MEM_GUARD_TEST_REDZONE; l++)
+      {
+        size = MEM_ALIGN_TEST_OFFSETS + o + l;
+        exact = (uint8_t *)malloc(size);
+        if ((! exact ) ||
+            (test_move_check(exact, ref, size, size - l, size - l - k, l) !=
+             TEST_NO_ERROR))
+        {
+          ret = TEST_ERROR;
+        }
+        free(exact);
+
+        size = o + k + l;
+        exact = (uint8_t *)malloc(size);
+        if ((! exact ) ||
+            (test_move_check(exact, ref, size, o, o + k, l) != TEST_NO_ERROR))
+        {
+          ret = TEST_ERROR;
+        }
+        free(exact);
+      }
+    }
+  }
+
+  test_guard_unmap(data, page);
+  free(ref);
+  return ret;
+#else
+  return TEST_NO_ERROR;
+#endif
+}
+
+int8_t test_memset_align()
+{
+  size_t threshold = my_mem_stream_threshold();
+  size_t i;
+  size_t d;
+  size_t l;
+  size_t length;
+  uint8_t value;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * dst;
+  uint8_t * ref;
+
+  PRINTF("test_memset_align()\n");
+  dst = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  ref = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  if ((! dst ) || (! ref ))
+  {
+    free_aligned( (uint32_t*)dst );
+    free_aligned( (uint32_t*)ref );
+    return TEST_ERROR;
+  }
+
+  my_mem_set_stream_threshold(MEM_ALIGN_TEST_STREAM);
+  for (d = 0; d < MEM_ALIGN_TEST_OFFSETS; d++)
+  {
+    for (l = 0; l < sizeof(test_align_lengths) / sizeof(size_t); l++)
+    {
+      length = test_align_lengths[l];
+      value = (uint8_t)(0x51 + d);
+      for( i = 0; i < MEM_ALIGN_TEST_SIZE_B; i++)
+      {
+        dst[i] = 0xEE;
+        ref[i] = ((i >= d) && (i < d + length)) ? value : 0xEE;
+      }
+      my_memset(&dst[d], length, value);
+      if (test_bytes_equal(dst, ref, MEM_ALIGN_TEST_SIZE_B) != TEST_NO_ERROR)
+      {
+        ret = TEST_ERROR;
+      }
+
+      for( i = d; i < d + length; i++)
+      {
+        ref[i] = 0;
+      }
+      my_memzero(&dst[d], length);
+      if (test_bytes_equal(dst, ref, MEM_ALIGN_TEST_SIZE_B) != TEST_NO_ERROR)
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+  my_mem_set_stream_threshold(threshold);
+
+  free_aligned( (uint32_t*)dst );
+  free_aligned( (uint32_t*)ref );
+  return ret;
+}
+
+int8_t test_reverse_align()
+{
+  size_t i;
+  size_t d;
+  size_t l;
+  size_t length;
+  int8_t ret = TEST_NO_ERROR;
+  uint8_t * set;
+  uint8_t * ref;
+
+  PRINTF("test_reverse_align()\n");
+  set = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  ref = (uint8_t*)reserve_aligned(MEM_ALIGN_TEST_SIZE_W, MEM_STREAM_ALIGN);
+  if ((! set ) || (! ref ))
+  {
+    free_aligned( (uint32_t*)set );
+    free_aligned( (uint32_t*)ref );
+    return TEST_ERROR;
+  }
+
+  for (d = 0; d < MEM_ALIGN_TEST_OFFSETS; d++)
+  {
+    for (l = 0; l < sizeof(test_align_lengths) / sizeof(size_t); l++)
+    {
+      length = test_align_lengths[l];
+      for( i = 0; i < MEM_ALIGN_TEST_SIZE_B; i++)
+      {
+        set[i] = (uint8_t)((i * 7) ^ (i >> 8));
+        ref[i] = set[i];
+      }
+      for( i = 0; i < length; i++)
+      {
+        ref[d + i] = set[d + length - 1 - i];
+      }
+      my_reverse(&set[d], length);
+      if (test_bytes_equal(set, ref, MEM_ALIGN_TEST_SIZE_B) != TEST_NO_ERROR)
+      {
+        ret = TEST_ERROR;
+      }
+    }
+  }
+
+  free_aligned( (uint32_t*)set );
+  free_aligned( (uint32_t*)ref );
+  return ret;
+}
+
+void course1(void) 
+{
+  uint8_t i;
+  int8_t failed = 0;
+  int8_t results[TESTCOUNT];
+
+  results[0] = test_data1();
+  results[1] = test_data2();
+  results[2] = test_memmove1();
+  results[3] = test_memmove2();
+  results[4] = test_memmove3();
+  results[5] = test_memcopy();
+  results[6] = test_memset();
+  results[7] = test_reverse();
+  results[8] = test_memlarge();
+  results[9] = test_arena();
+  results[10] = test_aligned();
+  results[11] = test_memcmp();
+  results[12] = test_memcopy_batch();
+  results[13] = test_values();
+  results[14] = test_memfixed();
+  results[15] = test_crc32c();
+  results[16] = test_dma();
+  results[17] = test_buffer();
+  results[18] = test_ring();
+  results[19] = test_mpmc();
+  results[20] = test_memstream();
+  results[21] = test_memparallel();
+  results[22] = test_elements();
+  results[23] = test_memstats();
+  results[24] = test_pool_threads();
+  results[25] = test_pool_huge();
+  results[26] = test_ring_threads();
+  results[27] = test_mpmc_threads();
+  results[28] = test_memcopy_align();
+  results[29] = test_memcopy_guard();
+  results[30] = test_memmove_align();
+  results[31] = test_memmove_guard();
+  results[32] = test_memset_align();
+  results[33] = test_reverse_align();
+
+  for ( i = 0; i < TESTCOUNT; i++) 
+  {
+    failed += results[i];
+  }
+
+  PRINTF("--------------------------------\n");
+  PRINTF("Test Results:\n");
+  PRINTF("  PASSED: %d / %d\n", (TESTCOUNT - failed), TESTCOUNT);
+  PRINTF("  FAILED: %d / %d\n", failed, TESTCOUNT);
+  PRINTF("--------------------------------\n");
+
+  #ifdef MEM_STATS
+  mem_stats_print();
+  #endif
 }
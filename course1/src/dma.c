@@ -0,0 +1,278 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file dma.c
+ * @brief Asynchronous DMA style copy engine
+ *
+ * Submitted descriptors sit in a ring until the worker runs them. Three
+ * counters describe the ring: submitted, completed and reaped. A ticket is
+ * the value of submitted after its descriptor was queued, so a transfer is
+ * complete once completed has caught up with its ticket. The counters are
+ * 64 bits wide so tickets never wrap.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#if defined (HOST)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include "../include/common/dma.h"
+#include "../include/common/memory.h"
+
+#if defined (HOST)
+#include <pthread.h>
+#endif
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+struct dma_engine {
+  dma_backend_t backend;                          /* Copy of the backend */
+  dma_desc_t queue[DMA_QUEUE_DEPTH];              /* Pending descriptors */
+  dma_completion_t completions[DMA_QUEUE_DEPTH];  /* Completion records */
+  uint64_t submitted;  /* Descriptors queued so far */
+  uint64_t completed;  /* Descriptors finished so far */
+  uint64_t reaped;     /* Completion records taken so far */
+#if defined (HOST)
+  pthread_mutex_t lock;    /* Guards the ring and counters */
+  pthread_cond_t work;     /* Signalled when a descriptor is queued */
+  pthread_cond_t done;     /* Signalled when a descriptor finishes */
+  pthread_t worker;        /* Thread running the transfers */
+  int stopping;            /* Set by dma_destroy() */
+#endif
+};
+
+/**
+ * @brief Runs a descriptor with the memory.h kernels.
+ *
+ * @param context Unused.
+ * @param desc Pointer to the descriptor.
+ *
+ * @return void.
+ */
+static void dma_transfer_memory(void * context, const dma_desc_t * desc){
+  (void)context;
+
+  if(desc->op == DMA_OP_SET){
+    my_memset(desc->dst, desc->length, desc->value);
+  }else{
+    my_memcopy(desc->src, desc->dst, desc->length);
+  }
+}
+
+static const dma_backend_t dma_backend_memory = {
+  "memory",
+  dma_transfer_memory,
+  NULL
+};
+
+/**
+ * @brief Runs the descriptor at the head of the ring and records it.
+ *
+ * On the host the caller holds the lock on entry and on return; it is
+ * dropped while the transfer runs.
+ *
+ * @param engine Pointer to the engine.
+ *
+ * @return void.
+ */
+static void dma_run_next(dma_engine_t * engine){
+  size_t index = (size_t)(engine->completed % DMA_QUEUE_DEPTH);
+  dma_desc_t desc = engine->queue[index];
+
+#if defined (HOST)
+  pthread_mutex_unlock(&engine->lock);
+  engine->backend.transfer(engine->backend.context, &desc);
+  pthread_mutex_lock(&engine->lock);
+#else
+  engine->backend.transfer(engine->backend.context, &desc);
+#endif
+
+  engine->completions[index].ticket = engine->completed + 1;
+  engine->completions[index].user = desc.user;
+  engine->completed++;
+}
+
+#if defined (HOST)
+/**
+ * @brief Worker thread running queued transfers until the engine stops.
+ *
+ * @param arg Pointer to the engine.
+ *
+ * @return NULL.
+ */
+static void * dma_worker(void * arg){
+  dma_engine_t * engine = (dma_engine_t *)arg;
+
+  pthread_mutex_lock(&engine->lock);
+  for(;;){
+    while((engine->completed == engine->submitted) && (! engine->stopping)){
+      pthread_cond_wait(&engine->work, &engine->lock);
+    }
+    if(engine->completed == engine->submitted){
+      break;
+    }
+    dma_run_next(engine);
+    pthread_cond_broadcast(&engine->done);
+  }
+  pthread_mutex_unlock(&engine->lock);
+  return NULL;
+}
+#endif /* HOST */
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+dma_engine_t * dma_create(const dma_backend_t * backend){
+  dma_engine_t * engine = (dma_engine_t *)calloc(1, sizeof(dma_engine_t));
+
+  if(engine == NULL){
+    return NULL;
+  }
+  engine->backend = (backend != NULL) ? *backend : dma_backend_memory;
+
+#if defined (HOST)
+  if(pthread_mutex_init(&engine->lock, NULL) != 0){
+    free(engine);
+    return NULL;
+  }
+  pthread_cond_init(&engine->work, NULL);
+  pthread_cond_init(&engine->done, NULL);
+  if(pthread_create(&engine->worker, NULL, dma_worker, engine) != 0){
+    pthread_cond_destroy(&engine->work);
+    pthread_cond_destroy(&engine->done);
+    pthread_mutex_destroy(&engine->lock);
+    free(engine);
+    return NULL;
+  }
+#endif
+
+  return engine;
+}
+
+void dma_destroy(dma_engine_t * engine){
+  if(engine == NULL){
+    return;
+  }
+
+#if defined (HOST)
+  /* The worker drains the ring before it sees the stop flag. */
+  pthread_mutex_lock(&engine->lock);
+  engine->stopping = 1;
+  pthread_cond_signal(&engine->work);
+  pthread_mutex_unlock(&engine->lock);
+  pthread_join(engine->worker, NULL);
+
+  pthread_cond_destroy(&engine->work);
+  pthread_cond_destroy(&engine->done);
+  pthread_mutex_destroy(&engine->lock);
+#endif
+
+  free(engine);
+}
+
+dma_ticket_t dma_submit(dma_engine_t * engine, const dma_desc_t * desc){
+  dma_ticket_t ticket = DMA_TICKET_NONE;
+
+#if defined (HOST)
+  pthread_mutex_lock(&engine->lock);
+#endif
+
+  if((engine->submitted - engine->completed) < DMA_QUEUE_DEPTH){
+    engine->queue[engine->submitted % DMA_QUEUE_DEPTH] = *desc;
+    engine->submitted++;
+    ticket = engine->submitted;
+#if defined (HOST)
+    pthread_cond_signal(&engine->work);
+#else
+    dma_run_next(engine);
+#endif
+  }
+
+#if defined (HOST)
+  pthread_mutex_unlock(&engine->lock);
+#endif
+
+  return ticket;
+}
+
+int dma_poll(dma_engine_t * engine, dma_ticket_t ticket){
+  int done;
+
+#if defined (HOST)
+  pthread_mutex_lock(&engine->lock);
+  done = (engine->completed >= ticket);
+  pthread_mutex_unlock(&engine->lock);
+#else
+  done = (engine->completed >= ticket);
+#endif
+
+  return done;
+}
+
+void dma_wait(dma_engine_t * engine, dma_ticket_t ticket){
+#if defined (HOST)
+  pthread_mutex_lock(&engine->lock);
+  while(engine->completed < ticket){
+    pthread_cond_wait(&engine->done, &engine->lock);
+  }
+  pthread_mutex_unlock(&engine->lock);
+#else
+  (void)engine;
+  (void)ticket;
+#endif
+}
+
+void dma_wait_all(dma_engine_t * engine){
+#if defined (HOST)
+  pthread_mutex_lock(&engine->lock);
+  while(engine->completed != engine->submitted){
+    pthread_cond_wait(&engine->done, &engine->lock);
+  }
+  pthread_mutex_unlock(&engine->lock);
+#else
+  (void)engine;
+#endif
+}
+
+int dma_reap(dma_engine_t * engine, dma_completion_t * out){
+  int taken = 0;
+
+#if defined (HOST)
+  pthread_mutex_lock(&engine->lock);
+#endif
+
+  /* Records older than the ring have been overwritten; skip past them. */
+  if((engine->completed - engine->reaped) > DMA_QUEUE_DEPTH){
+    engine->reaped = engine->completed - DMA_QUEUE_DEPTH;
+  }
+  if(engine->reaped != engine->completed){
+    *out = engine->completions[engine->reaped % DMA_QUEUE_DEPTH];
+    engine->reaped++;
+    taken = 1;
+  }
+
+#if defined (HOST)
+  pthread_mutex_unlock(&engine->lock);
+#endif
+
+  return taken;
+}
+
+const char * dma_backend_name(dma_engine_t * engine){
+  return engine->backend.name;
+}
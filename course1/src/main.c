@@ -20,10 +20,17 @@
  */
 
 #include "../include/common/course1.h"
+#ifdef BENCH
+#include "../include/common/bench.h"
+#endif
 
 int main(void){
 
   #ifdef COURSE1
     course1();
   #endif
+
+  #ifdef BENCH
+    bench();
+  #endif
 }
@@ -24,64 +24,1535 @@
  *
  */
 
+#if defined(HOST)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "../include/common/memory.h"
+#include "../include/common/pool.h"
+#include "../include/common/memstats.h"
+
+#if defined(HOST)
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/* Vector kernels are only built for x86 hosts; the MSP432 and any other
+   target use the portable word-at-a-time kernels. */
+#if defined(HOST) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define MEM_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+/* Machine word moved by the copy engine. may_alias lets it walk the
+   byte buffers handed to us without breaking strict aliasing rules. */
+typedef uintptr_t __attribute__((__may_alias__)) mem_word_t;
+
+#define MEM_WORD_SIZE  (sizeof(mem_word_t))
+#define MEM_WORD_MASK  (MEM_WORD_SIZE - 1)
+
+/* Word read or written at any byte address. The packed wrapper makes the
+   compiler emit accesses that are safe on targets without unaligned
+   multi-word loads, such as LDRD/LDM on the Cortex-M4. */
+typedef struct __attribute__((__packed__, __may_alias__)) {
+  mem_word_t w;
+} mem_uword_t;
+
+/* Reverses the byte order of one word; a single REV/BSWAP instruction. */
+#if UINTPTR_MAX > 0xFFFFFFFFu
+#define MEM_BSWAP(w) ((mem_word_t)__builtin_bswap64((uint64_t)(w)))
+#else
+#define MEM_BSWAP(w) ((mem_word_t)__builtin_bswap32((uint32_t)(w)))
+#endif
+
+/* Bytes ahead of the current position that large sequential kernels
+   prefetch, 0 to leave it to the hardware prefetcher. */
+static size_t mem_prefetch_distance = MEM_PREFETCH_DISTANCE;
+
+/**
+ * @brief Returns how far ahead a kernel over length bytes should prefetch.
+ *
+ * Short operations find their data in the caches, and the extra
+ * instructions would only slow them down.
+ *
+ * @param length Length of bytes the kernel will read.
+ *
+ * @return Prefetch distance in bytes, 0 for no prefetching.
+ */
+static size_t mem_prefetch_ahead(size_t length){
+#if defined(MEM_NO_PREFETCH)
+  (void)length;
+  return 0;
+#else
+  return (length >= MEM_PREFETCH_MIN) ? mem_prefetch_distance : 0;
+#endif
+}
+
+/**
+ * @brief Copies bytes front to back, a machine word at a time.
+ *
+ * The destination is byte-copied up to a word boundary, the body is moved in
+ * whole words and the remaining tail is byte-copied. When the source does not
+ * share the destination alignment it is read through mem_uword_t, so no byte
+ * outside the source range is ever loaded. Safe for overlapping buffers as
+ * long as dst is below src.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes to copy.
+ *
+ * @return void.
+ */
+static void mem_copy_fwd(uint8_t * dst, const uint8_t * src, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t words;
+
+  /* Byte copy the head until the destination is word aligned. */
+  while((length > 0) && (((uintptr_t)dst & MEM_WORD_MASK) != 0)){
+    *dst++ = *src++;
+    length--;
+  }
+
+  words = length / MEM_WORD_SIZE;
+
+  if(words > 0){
+    mem_word_t * d = (mem_word_t *)dst;
+    size_t count = words;
+
+    if(((uintptr_t)src & MEM_WORD_MASK) == 0){
+      const mem_word_t * s = (const mem_word_t *)src;
+
+      /* Unrolled by four to keep several loads in flight. */
+      while(count >= 4){
+        if(ahead != 0){
+          MEM_PREFETCH((const uint8_t *)s + ahead);
+        }
+        d[0] = s[0];
+        d[1] = s[1];
+        d[2] = s[2];
+        d[3] = s[3];
+        d += 4;
+        s += 4;
+        count -= 4;
+      }
+      while(count > 0){
+        *d++ = *s++;
+        count--;
+      }
+    }else{
+      const mem_uword_t * s = (const mem_uword_t *)src;
+      mem_word_t w0, w1, w2, w3;
+
+      /* Loads before stores, as a move with dst below src needs. */
+      while(count >= 4){
+        if(ahead != 0){
+          MEM_PREFETCH((const uint8_t *)s + ahead);
+        }
+        w0 = s[0].w;
+        w1 = s[1].w;
+        w2 = s[2].w;
+        w3 = s[3].w;
+        d[0] = w0;
+        d[1] = w1;
+        d[2] = w2;
+        d[3] = w3;
+        d += 4;
+        s += 4;
+        count -= 4;
+      }
+      while(count > 0){
+        *d++ = (s++)->w;
+        count--;
+      }
+    }
+
+    dst += words * MEM_WORD_SIZE;
+    src += words * MEM_WORD_SIZE;
+    length -= words * MEM_WORD_SIZE;
+  }
+
+  /* Byte copy whatever is left of the tail. */
+  while(length > 0){
+    *dst++ = *src++;
+    length--;
+  }
+}
+
+/**
+ * @brief Copies bytes back to front, a machine word at a time.
+ *
+ * Mirror image of mem_copy_fwd(): the unaligned tail of the destination is
+ * byte-copied first, the body is moved in whole words walking downwards and
+ * the head is byte-copied last. A source misaligned relative to the
+ * destination is read through mem_uword_t, never outside its range. Safe for
+ * overlapping buffers as long as dst is above src.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes to copy.
+ *
+ * @return void.
+ */
+static void mem_copy_bwd(uint8_t * dst, const uint8_t * src, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t words;
+
+  dst += length;
+  src += length;
+
+  /* Byte copy the tail until the destination end is word aligned. */
+  while((length > 0) && (((uintptr_t)dst & MEM_WORD_MASK) != 0)){
+    *--dst = *--src;
+    length--;
+  }
+
+  words = length / MEM_WORD_SIZE;
+
+  if(words > 0){
+    mem_word_t * d = (mem_word_t *)dst;
+    size_t count = words;
+
+    if(((uintptr_t)src & MEM_WORD_MASK) == 0){
+      const mem_word_t * s = (const mem_word_t *)src;
+
+      while(count >= 4){
+        if(ahead != 0){
+          MEM_PREFETCH((const uint8_t *)s - ahead);
+        }
+        d -= 4;
+        s -= 4;
+        d[3] = s[3];
+        d[2] = s[2];
+        d[1] = s[1];
+        d[0] = s[0];
+        count -= 4;
+      }
+      while(count > 0){
+        *--d = *--s;
+        count--;
+      }
+    }else{
+      const mem_uword_t * s = (const mem_uword_t *)src;
+      mem_word_t w0, w1, w2, w3;
+
+      /* Loads before stores, as a move with dst above src needs. */
+      while(count >= 4){
+        if(ahead != 0){
+          MEM_PREFETCH((const uint8_t *)s - ahead);
+        }
+        d -= 4;
+        s -= 4;
+        w3 = s[3].w;
+        w2 = s[2].w;
+        w1 = s[1].w;
+        w0 = s[0].w;
+        d[3] = w3;
+        d[2] = w2;
+        d[1] = w1;
+        d[0] = w0;
+        count -= 4;
+      }
+      while(count > 0){
+        *--d = (--s)->w;
+        count--;
+      }
+    }
+
+    dst -= words * MEM_WORD_SIZE;
+    src -= words * MEM_WORD_SIZE;
+    length -= words * MEM_WORD_SIZE;
+  }
+
+  /* Byte copy whatever is left of the head. */
+  while(length > 0){
+    *--dst = *--src;
+    length--;
+  }
+}
+
+/**
+ * @brief Copies a fragment of at most MEM_BATCH_SMALL bytes.
+ *
+ * Two possibly overlapping loads of the largest size that fits cover the
+ * whole fragment, so there is no loop and no alignment work. Both loads are
+ * done before the stores.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes to copy, at most 16.
+ *
+ * @return void.
+ */
+static void mem_copy_small(uint8_t * dst, const uint8_t * src, size_t length){
+  if(length >= 8){
+    uint64_t head = ((const mem_u64_t *)src)->v;
+    uint64_t tail = ((const mem_u64_t *)(src + length - 8))->v;
+    ((mem_u64_t *)dst)->v = head;
+    ((mem_u64_t *)(dst + length - 8))->v = tail;
+  }else if(length >= 4){
+    uint32_t head = ((const mem_u32_t *)src)->v;
+    uint32_t tail = ((const mem_u32_t *)(src + length - 4))->v;
+    ((mem_u32_t *)dst)->v = head;
+    ((mem_u32_t *)(dst + length - 4))->v = tail;
+  }else if(length > 0){
+    uint8_t first = src[0];
+    uint8_t middle = src[length / 2];
+    uint8_t last = src[length - 1];
+    dst[0] = first;
+    dst[length / 2] = middle;
+    dst[length - 1] = last;
+  }
+}
+
+/**
+ * @brief Fills bytes with a value, a machine word at a time.
+ *
+ * @param dst Pointer to destination location.
+ * @param value Byte value replicated across the region.
+ * @param length Length of bytes to fill.
+ *
+ * @return void.
+ */
+static void mem_set_fwd(uint8_t * dst, uint8_t value, size_t length){
+  mem_word_t pattern = ((mem_word_t)-1 / 0xFF) * value;
+  size_t words;
+
+  /* Byte fill the head until the destination is word aligned. */
+  while((length > 0) && (((uintptr_t)dst & MEM_WORD_MASK) != 0)){
+    *dst++ = value;
+    length--;
+  }
+
+  words = length / MEM_WORD_SIZE;
+
+  if(words > 0){
+    mem_word_t * d = (mem_word_t *)dst;
+    size_t count = words;
+
+    while(count >= 4){
+      d[0] = pattern;
+      d[1] = pattern;
+      d[2] = pattern;
+      d[3] = pattern;
+      d += 4;
+      count -= 4;
+    }
+    while(count > 0){
+      *d++ = pattern;
+      count--;
+    }
+
+    dst += words * MEM_WORD_SIZE;
+    length -= words * MEM_WORD_SIZE;
+  }
+
+  /* Byte fill whatever is left of the tail. */
+  while(length > 0){
+    *dst++ = value;
+    length--;
+  }
+}
+
+/**
+ * @brief Reverses bytes in place, a machine word from each end at a time.
+ *
+ * A word is loaded from each end, byte swapped and stored at the opposite
+ * end. The middle left over when the ends meet is reversed byte by byte.
+ *
+ * @param lo Pointer to the first byte of the region.
+ * @param hi Pointer one past the last byte of the region.
+ *
+ * @return void.
+ */
+static void mem_reverse_words(uint8_t * lo, uint8_t * hi){
+  mem_word_t front;
+  mem_word_t back;
+  uint8_t temp;
+
+  while((size_t)(hi - lo) >= (2 * MEM_WORD_SIZE)){
+    hi -= MEM_WORD_SIZE;
+    front = ((mem_uword_t *)lo)->w;
+    back = ((mem_uword_t *)hi)->w;
+    ((mem_uword_t *)lo)->w = MEM_BSWAP(back);
+    ((mem_uword_t *)hi)->w = MEM_BSWAP(front);
+    lo += MEM_WORD_SIZE;
+  }
+
+  while((hi - lo) > 1){
+    hi--;
+    temp = *lo;
+    *lo = *hi;
+    *hi = temp;
+    lo++;
+  }
+}
+
+/**
+ * @brief Returns log2 of a supported element width.
+ *
+ * @param width Element width in bytes.
+ *
+ * @return 0 to 3 for widths of 1, 2, 4 and 8 bytes, -1 otherwise.
+ */
+static int mem_width_shift(size_t width){
+  switch(width){
+    case 1: return 0;
+    case 2: return 1;
+    case 4: return 2;
+    case 8: return 3;
+    default: return -1;
+  }
+}
+
+/**
+ * @brief Reverses the order of fixed width elements in place.
+ *
+ * Elements are swapped end for end with single loads and stores of their
+ * own width; the bytes inside an element keep their order.
+ *
+ * @param lo Pointer to the first byte of the region.
+ * @param hi Pointer one past the last byte of the region.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return void.
+ */
+static void mem_reverse_scalar(uint8_t * lo, uint8_t * hi, size_t width){
+  uint64_t front;
+
+  if(width == 1){
+    mem_reverse_words(lo, hi);
+    return;
+  }
+
+  while((size_t)(hi - lo) >= (2 * width)){
+    hi -= width;
+    switch(width){
+      case 2:
+        front = ((mem_u16_t *)lo)->v;
+        ((mem_u16_t *)lo)->v = ((mem_u16_t *)hi)->v;
+        ((mem_u16_t *)hi)->v = (uint16_t)front;
+        break;
+      case 4:
+        front = ((mem_u32_t *)lo)->v;
+        ((mem_u32_t *)lo)->v = ((mem_u32_t *)hi)->v;
+        ((mem_u32_t *)hi)->v = (uint32_t)front;
+        break;
+      default:
+        front = ((mem_u64_t *)lo)->v;
+        ((mem_u64_t *)lo)->v = ((mem_u64_t *)hi)->v;
+        ((mem_u64_t *)hi)->v = front;
+        break;
+    }
+    lo += width;
+  }
+}
+
+/**
+ * @brief Byte swaps fixed width elements from the source to the destination.
+ *
+ * Each element is loaded, swapped with a single REV/BSWAP and stored, so
+ * the source and destination may be the same buffer.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes, a multiple of width.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return void.
+ */
+static void mem_bswap_scalar(uint8_t * dst, const uint8_t * src, size_t length,
+                             size_t width){
+  size_t index;
+
+  switch(width){
+    case 2:
+      for(index = 0; index < length; index += 2){
+        ((mem_u16_t *)(dst + index))->v =
+          __builtin_bswap16(((const mem_u16_t *)(src + index))->v);
+      }
+      break;
+    case 4:
+      for(index = 0; index < length; index += 4){
+        ((mem_u32_t *)(dst + index))->v =
+          __builtin_bswap32(((const mem_u32_t *)(src + index))->v);
+      }
+      break;
+    case 8:
+      for(index = 0; index < length; index += 8){
+        ((mem_u64_t *)(dst + index))->v =
+          __builtin_bswap64(((const mem_u64_t *)(src + index))->v);
+      }
+      break;
+    default:
+      if(dst != src){
+        mem_copy_fwd(dst, src, length);
+      }
+      break;
+  }
+}
+
+/**
+ * @brief Finds the first byte where two regions differ, a word at a time.
+ *
+ * Words are compared until one differs; that word is then scanned byte by
+ * byte, which keeps the result independent of the byte order.
+ *
+ * @param a Pointer to the first region.
+ * @param b Pointer to the second region.
+ * @param length Length of bytes to compare.
+ *
+ * @return Index of the first differing byte, or length if none differ.
+ */
+static size_t mem_diff_scalar(const uint8_t * a, const uint8_t * b, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+
+  while((length - index) >= MEM_WORD_SIZE){
+    if((ahead != 0) && ((index & (MEM_PREFETCH_LINE - 1)) == 0)){
+      MEM_PREFETCH(a + index + ahead);
+      MEM_PREFETCH(b + index + ahead);
+    }
+    if(((const mem_uword_t *)(a + index))->w !=
+       ((const mem_uword_t *)(b + index))->w){
+      break;
+    }
+    index += MEM_WORD_SIZE;
+  }
+
+  while((index < length) && (a[index] == b[index])){
+    index++;
+  }
+  return index;
+}
+
+/**
+ * @brief Finds the first byte holding a value, a word at a time.
+ *
+ * Each word is xored with the value replicated across it, turning matches
+ * into zero bytes, and tested for a zero byte with the usual borrow trick.
+ * A word that may hold a match is then scanned byte by byte.
+ *
+ * @param src Pointer to the region to search.
+ * @param value Byte value to look for.
+ * @param length Length of bytes to search.
+ *
+ * @return Index of the first matching byte, or length if there is none.
+ */
+static size_t mem_find_scalar(const uint8_t * src, uint8_t value, size_t length){
+  const mem_word_t ones = (mem_word_t)-1 / 0xFF;
+  const mem_word_t highs = ones << 7;
+  mem_word_t pattern = ones * value;
+  mem_word_t word;
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+
+  while((length - index) >= MEM_WORD_SIZE){
+    if((ahead != 0) && ((index & (MEM_PREFETCH_LINE - 1)) == 0)){
+      MEM_PREFETCH(src + index + ahead);
+    }
+    word = ((const mem_uword_t *)(src + index))->w ^ pattern;
+    if(((word - ones) & ~word & highs) != 0){
+      break;
+    }
+    index += MEM_WORD_SIZE;
+  }
+
+  while((index < length) && (src[index] != value)){
+    index++;
+  }
+  return index;
+}
+
+#if defined(MEM_X86_SIMD)
+/**
+ * @brief Fills bytes with a value using 16 byte SSE2 stores.
+ *
+ * One unaligned store covers the head, the body is filled with aligned
+ * stores and a final unaligned store ending at the last byte covers the
+ * tail, overlapping the body where needed.
+ *
+ * @param dst Pointer to destination location.
+ * @param value Byte value replicated across the region.
+ * @param length Length of bytes to fill.
+ *
+ * @return void.
+ */
+__attribute__((target("sse2")))
+static void mem_set_sse2(uint8_t * dst, uint8_t value, size_t length){
+  __m128i v;
+  uint8_t * end = dst + length;
+  uint8_t * p;
+
+  if(length < 16){
+    mem_set_fwd(dst, value, length);
+    return;
+  }
+
+  v = _mm_set1_epi8((char)value);
+  _mm_storeu_si128((__m128i *)dst, v);
+  p = (uint8_t *)(((uintptr_t)dst + 16) & ~(uintptr_t)15);
+
+  while((size_t)(end - p) >= 64){
+    _mm_store_si128((__m128i *)p, v);
+    _mm_store_si128((__m128i *)(p + 16), v);
+    _mm_store_si128((__m128i *)(p + 32), v);
+    _mm_store_si128((__m128i *)(p + 48), v);
+    p += 64;
+  }
+  while((size_t)(end - p) >= 16){
+    _mm_store_si128((__m128i *)p, v);
+    p += 16;
+  }
+  _mm_storeu_si128((__m128i *)(end - 16), v);
+}
+
+/**
+ * @brief Fills bytes with a value using 32 byte AVX2 stores.
+ *
+ * Same head/body/tail layout as mem_set_sse2().
+ *
+ * @param dst Pointer to destination location.
+ * @param value Byte value replicated across the region.
+ * @param length Length of bytes to fill.
+ *
+ * @return void.
+ */
+__attribute__((target("avx2")))
+static void mem_set_avx2(uint8_t * dst, uint8_t value, size_t length){
+  __m256i v;
+  uint8_t * end = dst + length;
+  uint8_t * p;
+
+  if(length < 32){
+    mem_set_sse2(dst, value, length);
+    return;
+  }
+
+  v = _mm256_set1_epi8((char)value);
+  _mm256_storeu_si256((__m256i *)dst, v);
+  p = (uint8_t *)(((uintptr_t)dst + 32) & ~(uintptr_t)31);
+
+  while((size_t)(end - p) >= 128){
+    _mm256_store_si256((__m256i *)p, v);
+    _mm256_store_si256((__m256i *)(p + 32), v);
+    _mm256_store_si256((__m256i *)(p + 64), v);
+    _mm256_store_si256((__m256i *)(p + 96), v);
+    p += 128;
+  }
+  while((size_t)(end - p) >= 32){
+    _mm256_store_si256((__m256i *)p, v);
+    p += 32;
+  }
+  _mm256_storeu_si256((__m256i *)(end - 32), v);
+}
+
+/**
+ * @brief Fills bytes with a value using 64 byte AVX-512 stores.
+ *
+ * Same head/body/tail layout as mem_set_sse2().
+ *
+ * @param dst Pointer to destination location.
+ * @param value Byte value replicated across the region.
+ * @param length Length of bytes to fill.
+ *
+ * @return void.
+ */
+__attribute__((target("avx512f")))
+static void mem_set_avx512(uint8_t * dst, uint8_t value, size_t length){
+  __m512i v;
+  uint8_t * end = dst + length;
+  uint8_t * p;
+
+  if(length < 64){
+    mem_set_avx2(dst, value, length);
+    return;
+  }
+
+  v = _mm512_set1_epi32((int)(0x01010101u * value));
+  _mm512_storeu_si512((void *)dst, v);
+  p = (uint8_t *)(((uintptr_t)dst + 64) & ~(uintptr_t)63);
+
+  while((size_t)(end - p) >= 256){
+    _mm512_store_si512((void *)p, v);
+    _mm512_store_si512((void *)(p + 64), v);
+    _mm512_store_si512((void *)(p + 128), v);
+    _mm512_store_si512((void *)(p + 192), v);
+    p += 256;
+  }
+  while((size_t)(end - p) >= 64){
+    _mm512_store_si512((void *)p, v);
+    p += 64;
+  }
+  _mm512_storeu_si512((void *)(end - 64), v);
+}
+
+/**
+ * @brief Copies bytes with non-temporal SSE2 stores.
+ *
+ * The head is copied normally up to a 16 byte destination boundary, the
+ * body is written with streaming stores that bypass the caches, and the
+ * tail is copied normally once the stores have been fenced.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes to copy.
+ *
+ * @return void.
+ */
+__attribute__((target("sse2")))
+static void mem_copy_stream_sse2(uint8_t * dst, const uint8_t * src, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t head = (size_t)(-(uintptr_t)dst & 15);
+  __m128i a, b, c, d;
+
+  if(length < (head + 64)){
+    mem_copy_fwd(dst, src, length);
+    return;
+  }
+
+  mem_copy_fwd(dst, src, head);
+  dst += head;
+  src += head;
+  length -= head;
+
+  while(length >= 64){
+    if(ahead != 0){
+      MEM_PREFETCH(src + ahead);
+    }
+    a = _mm_loadu_si128((const __m128i *)src);
+    b = _mm_loadu_si128((const __m128i *)(src + 16));
+    c = _mm_loadu_si128((const __m128i *)(src + 32));
+    d = _mm_loadu_si128((const __m128i *)(src + 48));
+    _mm_stream_si128((__m128i *)dst, a);
+    _mm_stream_si128((__m128i *)(dst + 16), b);
+    _mm_stream_si128((__m128i *)(dst + 32), c);
+    _mm_stream_si128((__m128i *)(dst + 48), d);
+    dst += 64;
+    src += 64;
+    length -= 64;
+  }
+  _mm_sfence();
+
+  mem_copy_fwd(dst, src, length);
+}
+
+/**
+ * @brief Fills bytes with a value using non-temporal SSE2 stores.
+ *
+ * Same head/body/tail layout as mem_copy_stream_sse2().
+ *
+ * @param dst Pointer to destination location.
+ * @param value Byte value replicated across the region.
+ * @param length Length of bytes to fill.
+ *
+ * @return void.
+ */
+__attribute__((target("sse2")))
+static void mem_set_stream_sse2(uint8_t * dst, uint8_t value, size_t length){
+  size_t head = (size_t)(-(uintptr_t)dst & 15);
+  __m128i v;
+
+  if(length < (head + 64)){
+    mem_set_fwd(dst, value, length);
+    return;
+  }
+
+  mem_set_fwd(dst, value, head);
+  dst += head;
+  length -= head;
+
+  v = _mm_set1_epi8((char)value);
+  while(length >= 64){
+    _mm_stream_si128((__m128i *)dst, v);
+    _mm_stream_si128((__m128i *)(dst + 16), v);
+    _mm_stream_si128((__m128i *)(dst + 32), v);
+    _mm_stream_si128((__m128i *)(dst + 48), v);
+    dst += 64;
+    length -= 64;
+  }
+  _mm_sfence();
+
+  mem_set_fwd(dst, value, length);
+}
+
+/* pshufb masks indexed by mem_width_shift(). A reverse mask reverses the
+   order of the elements in a 16 byte block, a swap mask reverses the bytes
+   inside each element. */
+static const uint8_t mem_reverse_masks[4][16] = {
+  {15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0},
+  {14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1},
+  {12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3},
+  {8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7}
+};
+
+static const uint8_t mem_bswap_masks[4][16] = {
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+  {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+  {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+  {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}
+};
+
+/**
+ * @brief Reverses elements in place with 16 byte SSSE3 shuffles.
+ *
+ * A block is loaded from each end, its elements reversed with pshufb and
+ * the blocks stored at the opposite ends. The middle is left to the scalar
+ * kernel.
+ *
+ * @param lo Pointer to the first byte of the region.
+ * @param hi Pointer one past the last byte of the region.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return void.
+ */
+__attribute__((target("ssse3")))
+static void mem_reverse_ssse3(uint8_t * lo, uint8_t * hi, size_t width){
+  const __m128i mask =
+    _mm_loadu_si128((const __m128i *)mem_reverse_masks[mem_width_shift(width)]);
+  __m128i front;
+  __m128i back;
+
+  while((size_t)(hi - lo) >= 32){
+    hi -= 16;
+    front = _mm_loadu_si128((const __m128i *)lo);
+    back = _mm_loadu_si128((const __m128i *)hi);
+    _mm_storeu_si128((__m128i *)lo, _mm_shuffle_epi8(back, mask));
+    _mm_storeu_si128((__m128i *)hi, _mm_shuffle_epi8(front, mask));
+    lo += 16;
+  }
+
+  mem_reverse_scalar(lo, hi, width);
+}
+
+/**
+ * @brief Reverses elements in place with 32 byte AVX2 shuffles.
+ *
+ * vpshufb only shuffles within 128 bit lanes, so each block is reversed
+ * per lane and the two lanes are then swapped with vpermq.
+ *
+ * @param lo Pointer to the first byte of the region.
+ * @param hi Pointer one past the last byte of the region.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return void.
+ */
+__attribute__((target("avx2")))
+static void mem_reverse_avx2(uint8_t * lo, uint8_t * hi, size_t width){
+  const __m256i mask = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128((const __m128i *)mem_reverse_masks[mem_width_shift(width)]));
+  __m256i front;
+  __m256i back;
+
+  while((size_t)(hi - lo) >= 64){
+    hi -= 32;
+    front = _mm256_loadu_si256((const __m256i *)lo);
+    back = _mm256_loadu_si256((const __m256i *)hi);
+    back = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(back, mask), 0x4E);
+    front = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(front, mask), 0x4E);
+    _mm256_storeu_si256((__m256i *)lo, back);
+    _mm256_storeu_si256((__m256i *)hi, front);
+    lo += 32;
+  }
+
+  /* The SSSE3 kernel is legacy SSE encoded; running it with dirty upper
+     halves costs a state transition on every call. */
+  _mm256_zeroupper();
+  mem_reverse_ssse3(lo, hi, width);
+}
+
+/**
+ * @brief Byte swaps elements with 16 byte SSSE3 shuffles.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes, a multiple of width.
+ * @param width Element width in bytes: 2, 4 or 8.
+ *
+ * @return void.
+ */
+__attribute__((target("ssse3")))
+static void mem_bswap_ssse3(uint8_t * dst, const uint8_t * src, size_t length,
+                            size_t width){
+  const __m128i mask =
+    _mm_loadu_si128((const __m128i *)mem_bswap_masks[mem_width_shift(width)]);
+
+  while(length >= 16){
+    _mm_storeu_si128((__m128i *)dst,
+      _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)src), mask));
+    dst += 16;
+    src += 16;
+    length -= 16;
+  }
+
+  mem_bswap_scalar(dst, src, length, width);
+}
+
+/**
+ * @brief Byte swaps elements with 32 byte AVX2 shuffles.
+ *
+ * Elements never straddle a 128 bit lane, so vpshufb needs no lane fix-up.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location.
+ * @param length Length of bytes, a multiple of width.
+ * @param width Element width in bytes: 2, 4 or 8.
+ *
+ * @return void.
+ */
+__attribute__((target("avx2")))
+static void mem_bswap_avx2(uint8_t * dst, const uint8_t * src, size_t length,
+                           size_t width){
+  const __m256i mask = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128((const __m128i *)mem_bswap_masks[mem_width_shift(width)]));
+
+  while(length >= 32){
+    _mm256_storeu_si256((__m256i *)dst,
+      _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)src), mask));
+    dst += 32;
+    src += 32;
+    length -= 32;
+  }
+
+  mem_bswap_ssse3(dst, src, length, width);
+}
+
+/**
+ * @brief Finds the first byte where two regions differ with SSE2 compares.
+ *
+ * 16 byte blocks are compared with pcmpeqb and the first clear bit of the
+ * movemask gives the position. The last partial block is covered by one
+ * load ending at the last byte, so nothing past either region is read.
+ *
+ * @param a Pointer to the first region.
+ * @param b Pointer to the second region.
+ * @param length Length of bytes to compare.
+ *
+ * @return Index of the first differing byte, or length if none differ.
+ */
+__attribute__((target("sse2")))
+static size_t mem_diff_sse2(const uint8_t * a, const uint8_t * b, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+  unsigned int mask;
+
+  if(length < 16){
+    return mem_diff_scalar(a, b, length);
+  }
+
+  for(;;){
+    if(index > (length - 16)){
+      index = length - 16;
+    }
+    if((ahead != 0) && ((index & (MEM_PREFETCH_LINE - 1)) == 0)){
+      MEM_PREFETCH(a + index + ahead);
+      MEM_PREFETCH(b + index + ahead);
+    }
+    mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(
+      _mm_loadu_si128((const __m128i *)(a + index)),
+      _mm_loadu_si128((const __m128i *)(b + index))));
+    if(mask != 0xFFFFu){
+      return index + (size_t)__builtin_ctz(~mask);
+    }
+    if((index + 16) >= length){
+      return length;
+    }
+    index += 16;
+  }
+}
+
+/**
+ * @brief Finds the first byte where two regions differ with AVX2 compares.
+ *
+ * Same layout as mem_diff_sse2() with 32 byte blocks.
+ *
+ * @param a Pointer to the first region.
+ * @param b Pointer to the second region.
+ * @param length Length of bytes to compare.
+ *
+ * @return Index of the first differing byte, or length if none differ.
+ */
+__attribute__((target("avx2")))
+static size_t mem_diff_avx2(const uint8_t * a, const uint8_t * b, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+  uint32_t mask;
+
+  if(length < 32){
+    return mem_diff_sse2(a, b, length);
+  }
+
+  for(;;){
+    if(index > (length - 32)){
+      index = length - 32;
+    }
+    if((ahead != 0) && ((index & (MEM_PREFETCH_LINE - 1)) == 0)){
+      MEM_PREFETCH(a + index + ahead);
+      MEM_PREFETCH(b + index + ahead);
+    }
+    mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+      _mm256_loadu_si256((const __m256i *)(a + index)),
+      _mm256_loadu_si256((const __m256i *)(b + index))));
+    if(mask != 0xFFFFFFFFu){
+      return index + (size_t)__builtin_ctz(~mask);
+    }
+    if((index + 32) >= length){
+      return length;
+    }
+    index += 32;
+  }
+}
+
+/**
+ * @brief Finds the first byte where two regions differ with AVX-512 compares.
+ *
+ * Same layout as mem_diff_sse2() with 64 byte blocks; vpcmpneqb produces
+ * the difference mask directly.
+ *
+ * @param a Pointer to the first region.
+ * @param b Pointer to the second region.
+ * @param length Length of bytes to compare.
+ *
+ * @return Index of the first differing byte, or length if none differ.
+ */
+__attribute__((target("avx512f,avx512bw")))
+static size_t mem_diff_avx512(const uint8_t * a, const uint8_t * b, size_t length){
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+  __mmask64 mask;
+
+  if(length < 64){
+    return mem_diff_avx2(a, b, length);
+  }
+
+  for(;;){
+    if(index > (length - 64)){
+      index = length - 64;
+    }
+    if((ahead != 0) && ((index & (MEM_PREFETCH_LINE - 1)) == 0)){
+      MEM_PREFETCH(a + index + ahead);
+      MEM_PREFETCH(b + index + ahead);
+    }
+    mask = _mm512_cmpneq_epi8_mask(
+      _mm512_loadu_si512((const void *)(a + index)),
+      _mm512_loadu_si512((const void *)(b + index)));
+    if(mask != 0){
+      return index + (size_t)__builtin_ctzll(mask);
+    }
+    if((index + 64) >= length){
+      return length;
+    }
+    index += 64;
+  }
+}
+
+/**
+ * @brief Finds the first byte holding a value with SSE2 compares.
+ *
+ * Four blocks are compared per iteration and only tested together, so a
+ * long scan costs one branch per 64 bytes. The tail is covered by one load
+ * ending at the last byte, as in mem_diff_sse2().
+ *
+ * @param src Pointer to the region to search.
+ * @param value Byte value to look for.
+ * @param length Length of bytes to search.
+ *
+ * @return Index of the first matching byte, or length if there is none.
+ */
+__attribute__((target("sse2")))
+static size_t mem_find_sse2(const uint8_t * src, uint8_t value, size_t length){
+  __m128i v;
+  __m128i a, b, c, d;
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+  unsigned int mask;
+
+  if(length < 16){
+    return mem_find_scalar(src, value, length);
+  }
+
+  v = _mm_set1_epi8((char)value);
+
+  while((length - index) >= 64){
+    if(ahead != 0){
+      MEM_PREFETCH(src + index + ahead);
+    }
+    a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(src + index)), v);
+    b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(src + index + 16)), v);
+    c = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(src + index + 32)), v);
+    d = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(src + index + 48)), v);
+    if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0){
+      break;
+    }
+    index += 64;
+  }
+
+  for(;;){
+    if(index > (length - 16)){
+      index = length - 16;
+    }
+    mask = (unsigned int)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(src + index)), v));
+    if(mask != 0){
+      return index + (size_t)__builtin_ctz(mask);
+    }
+    if((index + 16) >= length){
+      return length;
+    }
+    index += 16;
+  }
+}
+
+/**
+ * @brief Finds the first byte holding a value with AVX2 compares.
+ *
+ * Same layout as mem_find_sse2() with 32 byte blocks.
+ *
+ * @param src Pointer to the region to search.
+ * @param value Byte value to look for.
+ * @param length Length of bytes to search.
+ *
+ * @return Index of the first matching byte, or length if there is none.
+ */
+__attribute__((target("avx2")))
+static size_t mem_find_avx2(const uint8_t * src, uint8_t value, size_t length){
+  __m256i v;
+  __m256i a, b, c, d;
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+  uint32_t mask;
+
+  if(length < 32){
+    return mem_find_sse2(src, value, length);
+  }
+
+  v = _mm256_set1_epi8((char)value);
+
+  while((length - index) >= 128){
+    if(ahead != 0){
+      MEM_PREFETCH(src + index + ahead);
+      MEM_PREFETCH(src + index + ahead + 64);
+    }
+    a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(src + index)), v);
+    b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(src + index + 32)), v);
+    c = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(src + index + 64)), v);
+    d = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(src + index + 96)), v);
+    if(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b),
+                                            _mm256_or_si256(c, d))) != 0){
+      break;
+    }
+    index += 128;
+  }
+
+  for(;;){
+    if(index > (length - 32)){
+      index = length - 32;
+    }
+    mask = (uint32_t)_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(src + index)), v));
+    if(mask != 0){
+      return index + (size_t)__builtin_ctz(mask);
+    }
+    if((index + 32) >= length){
+      return length;
+    }
+    index += 32;
+  }
+}
+
+/**
+ * @brief Finds the first byte holding a value with AVX-512 compares.
+ *
+ * Same layout as mem_find_sse2() with 64 byte blocks.
+ *
+ * @param src Pointer to the region to search.
+ * @param value Byte value to look for.
+ * @param length Length of bytes to search.
+ *
+ * @return Index of the first matching byte, or length if there is none.
+ */
+__attribute__((target("avx512f,avx512bw")))
+static size_t mem_find_avx512(const uint8_t * src, uint8_t value, size_t length){
+  __m512i v;
+  size_t ahead = mem_prefetch_ahead(length);
+  size_t index = 0;
+  __mmask64 mask;
+
+  if(length < 64){
+    return mem_find_avx2(src, value, length);
+  }
+
+  v = _mm512_set1_epi8((char)value);
+
+  while((length - index) >= 256){
+    if(ahead != 0){
+      MEM_PREFETCH(src + index + ahead);
+      MEM_PREFETCH(src + index + ahead + 64);
+      MEM_PREFETCH(src + index + ahead + 128);
+      MEM_PREFETCH(src + index + ahead + 192);
+    }
+    mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(src + index)), v) |
+           _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(src + index + 64)), v) |
+           _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(src + index + 128)), v) |
+           _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(src + index + 192)), v);
+    if(mask != 0){
+      break;
+    }
+    index += 256;
+  }
+
+  for(;;){
+    if(index > (length - 64)){
+      index = length - 64;
+    }
+    mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)(src + index)), v);
+    if(mask != 0){
+      return index + (size_t)__builtin_ctzll(mask);
+    }
+    if((index + 64) >= length){
+      return length;
+    }
+    index += 64;
+  }
+}
+#endif /* MEM_X86_SIMD */
+
+/* Kernels used by the public functions. They start out as the portable
+   versions and are upgraded once at startup by mem_dispatch_init() when
+   the host CPU supports wider vectors. Targets without non-temporal stores
+   use the regular kernels for the streaming entries. */
+static struct {
+  const char * isa;
+  void (*set)(uint8_t * dst, uint8_t value, size_t length);
+  void (*copy_stream)(uint8_t * dst, const uint8_t * src, size_t length);
+  void (*set_stream)(uint8_t * dst, uint8_t value, size_t length);
+  void (*reverse)(uint8_t * lo, uint8_t * hi, size_t width);
+  void (*bswap)(uint8_t * dst, const uint8_t * src, size_t length, size_t width);
+  size_t (*diff)(const uint8_t * a, const uint8_t * b, size_t length);
+  size_t (*find)(const uint8_t * src, uint8_t value, size_t length);
+} mem_kernels = {
+  "scalar",
+  mem_set_fwd,
+  mem_copy_fwd,
+  mem_set_fwd,
+  mem_reverse_scalar,
+  mem_bswap_scalar,
+  mem_diff_scalar,
+  mem_find_scalar
+};
+
+/* Buffer copied, and how many times per candidate, to time each prefetch
+   distance; large enough to miss in the last level cache. */
+#define MEM_CALIBRATE_SIZE   ((size_t)64 << 20)
+#define MEM_CALIBRATE_ROUNDS (3)
+
+/* Length from which MEM_STREAM_AUTO switches to non-temporal stores. */
+static size_t mem_stream_threshold = MEM_STREAM_THRESHOLD;
+
+/**
+ * @brief Decides whether a copy or fill should bypass the caches.
+ *
+ * @param length Length of bytes of the operation.
+ * @param mode Streaming mode requested by the caller.
+ *
+ * @return Non-zero when the streaming kernel should be used.
+ */
+static int mem_streaming(size_t length, mem_stream_t mode){
+  if(mode == MEM_STREAM_ALWAYS){
+    return 1;
+  }
+  if(mode == MEM_STREAM_NEVER){
+    return 0;
+  }
+  return (length >= mem_stream_threshold);
+}
+
+#if defined(MEM_X86_SIMD)
+/**
+ * @brief Selects the widest kernels the host CPU supports.
+ *
+ * Runs as a constructor, before main() and before any thread can call
+ * into this file, so the kernel table never changes while in use.
+ *
+ * @return void.
+ */
+__attribute__((constructor))
+static void mem_dispatch_init(void){
+  long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+  /* Stream once an operation would fill most of the last level cache. */
+  if(llc > 0){
+    mem_stream_threshold = ((size_t)llc / 4) * 3;
+  }
+
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("sse2")){
+    mem_kernels.copy_stream = mem_copy_stream_sse2;
+    mem_kernels.set_stream = mem_set_stream_sse2;
+  }
+
+  if(__builtin_cpu_supports("avx2")){
+    mem_kernels.reverse = mem_reverse_avx2;
+    mem_kernels.bswap = mem_bswap_avx2;
+  }else if(__builtin_cpu_supports("ssse3")){
+    mem_kernels.reverse = mem_reverse_ssse3;
+    mem_kernels.bswap = mem_bswap_ssse3;
+  }
+
+  if(__builtin_cpu_supports("avx512bw")){
+    mem_kernels.diff = mem_diff_avx512;
+    mem_kernels.find = mem_find_avx512;
+  }else if(__builtin_cpu_supports("avx2")){
+    mem_kernels.diff = mem_diff_avx2;
+    mem_kernels.find = mem_find_avx2;
+  }else if(__builtin_cpu_supports("sse2")){
+    mem_kernels.diff = mem_diff_sse2;
+    mem_kernels.find = mem_find_sse2;
+  }
+
+  if(__builtin_cpu_supports("avx512f")){
+    mem_kernels.isa = "avx512";
+    mem_kernels.set = mem_set_avx512;
+  }else if(__builtin_cpu_supports("avx2")){
+    mem_kernels.isa = "avx2";
+    mem_kernels.set = mem_set_avx2;
+  }else if(__builtin_cpu_supports("sse2")){
+    mem_kernels.isa = "sse2";
+    mem_kernels.set = mem_set_sse2;
+  }
+}
+#endif /* MEM_X86_SIMD */
+
+#if defined(HOST)
+/**
+ * @brief Slice of a parallel copy or fill handed to one thread.
+ */
+typedef struct {
+  uint8_t * dst;        /* Start of this slice of the destination */
+  const uint8_t * src;  /* Start of this slice of the source, NULL to fill */
+  size_t length;        /* Length of bytes of this slice */
+  uint8_t value;        /* Fill value when src is NULL */
+  mem_stream_t mode;    /* Store policy decided for the whole operation */
+} mem_chunk_t;
+
+/**
+ * @brief Thread entry point running one slice of a parallel operation.
+ *
+ * @param arg Pointer to the mem_chunk_t describing the slice.
+ *
+ * @return NULL.
+ */
+static void * mem_chunk_run(void * arg){
+  mem_chunk_t * chunk = (mem_chunk_t *)arg;
+
+  if(chunk->src != NULL){
+    my_memcopy_stream((uint8_t *)chunk->src, chunk->dst, chunk->length,
+                      chunk->mode);
+  }else{
+    my_memset_stream(chunk->dst, chunk->length, chunk->value, chunk->mode);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Splits a copy or fill into slices and runs them on several threads.
+ *
+ * Slice boundaries fall on MEM_PARALLEL_ALIGN boundaries of the
+ * destination, so no two threads write the same cache line; the first and
+ * last slices take the misaligned head and tail. The calling thread runs
+ * the first slice itself; a slice whose thread cannot be created is run
+ * inline as well.
+ *
+ * @param dst Pointer to destination location.
+ * @param src Pointer to source location, or NULL to fill with value.
+ * @param length Length of bytes of the whole operation.
+ * @param value Fill value when src is NULL.
+ * @param threads Number of threads requested, 0 for one per online CPU.
+ *
+ * @return void.
+ */
+static void mem_parallel(uint8_t * dst, const uint8_t * src, size_t length,
+                         uint8_t value, unsigned int threads){
+  mem_chunk_t chunks[MEM_PARALLEL_MAX_THREADS];
+  pthread_t workers[MEM_PARALLEL_MAX_THREADS];
+  int started[MEM_PARALLEL_MAX_THREADS];
+  mem_stream_t mode = mem_streaming(length, MEM_STREAM_AUTO) ?
+                      MEM_STREAM_ALWAYS : MEM_STREAM_NEVER;
+  size_t head = (size_t)(-(uintptr_t)dst & (MEM_PARALLEL_ALIGN - 1));
+  size_t slice;
+  size_t end;
+  size_t offset = 0;
+  unsigned int count = 0;
+  unsigned int i;
+
+  if(threads == 0){
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (online > 0) ? (unsigned int)online : 1;
+  }
+  if(threads > MEM_PARALLEL_MAX_THREADS){
+    threads = MEM_PARALLEL_MAX_THREADS;
+  }
+  if(length < MEM_PARALLEL_CUTOFF){
+    threads = 1;
+  }
+
+  slice = (length + threads - 1) / threads;
+  slice = (slice + MEM_PARALLEL_ALIGN - 1) & ~(size_t)(MEM_PARALLEL_ALIGN - 1);
+
+  /* At most threads slices, as the first one also covers the head */
+  while(offset < length){
+    end = ((count == 0) ? head : offset) + slice;
+    chunks[count].dst = dst + offset;
+    chunks[count].src = (src != NULL) ? (src + offset) : NULL;
+    chunks[count].length = ((end < length) ? end : length) - offset;
+    chunks[count].value = value;
+    chunks[count].mode = mode;
+    offset += chunks[count].length;
+    count++;
+  }
+
+  for(i = 1; i < count; i++){
+    started[i] = (pthread_create(&workers[i], NULL, mem_chunk_run, &chunks[i]) == 0);
+    if(! started[i]){
+      mem_chunk_run(&chunks[i]);
+    }
+  }
+  if(count > 0){
+    mem_chunk_run(&chunks[0]);
+  }
+  for(i = 1; i < count; i++){
+    if(started[i]){
+      pthread_join(workers[i], NULL);
+    }
+  }
+}
+#endif /* HOST */
 
 /***********************************************************
                     Function Definitions
 ***********************************************************/
 
 /**
- * @brief Sets a value of a data array.
+ * @brief Names the instruction set picked for the memory kernels.
  *
- * Given a pointer to a char data set, this will set a provided
- * index into that data set to the value provided.
+ * @return "scalar", "sse2", "avx2" or "avx512".
+ */
+const char * my_mem_isa(void){
+  return mem_kernels.isa;
+}
+
+/**
+ * @brief Sets the length from which copies and fills stream past the caches.
  *
- * @param ptr Pointer to data array.
- * @param index Index into pointer array to set value.
- * @param value Value to write to the location.
+ * @param length Threshold in bytes used by MEM_STREAM_AUTO.
  *
  * @return void.
  */
-void set_value(char * ptr, unsigned int index, char value){
-  ptr[index] = value;
+void my_mem_set_stream_threshold(size_t length){
+  mem_stream_threshold = length;
 }
 
 /**
- * @brief Clears a value of a data array·
+ * @brief Returns the length from which copies and fills stream past the caches.
  *
- * Given a pointer to a char data set, this will clear a provided
- * index into that data set to the value zero.
+ * @return Threshold in bytes used by MEM_STREAM_AUTO.
+ */
+size_t my_mem_stream_threshold(void){
+  return mem_stream_threshold;
+}
+
+/**
+ * @brief Sets how far ahead large kernels prefetch.
  *
- * @param ptr Pointer to data array.
- * @param index Index into pointer array to set value.
+ * @param distance Distance in bytes, 0 to rely on the hardware prefetcher.
  *
  * @return void.
  */
-void clear_value(char * ptr, unsigned int index){
-  set_value(ptr, index, 0);
+void my_mem_set_prefetch_distance(size_t distance){
+  mem_prefetch_distance = distance;
 }
 
 /**
- * @brief Returns a value of a data array.
+ * @brief Returns how far ahead large kernels prefetch.
  *
- * Given a pointer to a char data set, this will read the provided
- * index into that data set and return the value.
+ * @return Distance in bytes, 0 when prefetching is off.
+ */
+size_t my_mem_prefetch_distance(void){
+  return mem_prefetch_ahead(MEM_PREFETCH_MIN);
+}
+
+/**
+ * @brief Picks the fastest prefetch distance for this machine.
  *
- * @param ptr Pointer to data array.
- * @param index Index into pointer array to set value.
+ * Each candidate times the best of MEM_CALIBRATE_ROUNDS copies of
+ * MEM_CALIBRATE_SIZE bytes, well past the caches, through the cached
+ * copy kernel. The previous distance is kept if the buffers cannot be
+ * reserved.
  *
- * @return Value to be read.
+ * @return Distance selected in bytes.
  */
-char get_value(char * ptr, unsigned int index){
-  return ptr[index];
+size_t my_mem_calibrate_prefetch(void){
+#if defined(HOST) && !defined(MEM_NO_PREFETCH)
+  static const size_t candidates[] = {0, 128, 256, 512, 1024, 2048, 4096};
+  struct timespec start;
+  struct timespec end;
+  uint8_t * src;
+  uint8_t * dst;
+  double best_time = 0.0;
+  double elapsed;
+  size_t best = mem_prefetch_distance;
+  size_t i;
+  unsigned int round;
+
+  src = (uint8_t *)reserve_words(MEM_CALIBRATE_SIZE / sizeof(int32_t));
+  dst = (uint8_t *)reserve_words(MEM_CALIBRATE_SIZE / sizeof(int32_t));
+  if((src != NULL) && (dst != NULL)){
+    my_memset(src, MEM_CALIBRATE_SIZE, 0x5A);
+    my_memzero(dst, MEM_CALIBRATE_SIZE);
+
+    for(i = 0; i < (sizeof(candidates) / sizeof(candidates[0])); i++){
+      mem_prefetch_distance = candidates[i];
+      for(round = 0; round < MEM_CALIBRATE_ROUNDS; round++){
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        mem_copy_fwd(dst, src, MEM_CALIBRATE_SIZE);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        elapsed = (double)(end.tv_sec - start.tv_sec) +
+                  ((double)(end.tv_nsec - start.tv_nsec) * 1e-9);
+        if((best_time == 0.0) || (elapsed < best_time)){
+          best_time = elapsed;
+          best = candidates[i];
+        }
+      }
+    }
+  }
+
+  free_words((uint32_t *)src);
+  free_words((uint32_t *)dst);
+  mem_prefetch_distance = best;
+  return best;
+#else
+  return my_mem_prefetch_distance();
+#endif
 }
 
+/* External definitions of the accessors inlined from memory.h, for
+   callers the compiler does not inline into. */
+extern inline void set_value(char * ptr, unsigned int index, char value);
+extern inline void clear_value(char * ptr, unsigned int index);
+extern inline char get_value(char * ptr, unsigned int index);
+
 /**
  * @brief Sets data array elements to a value.
  *
  * Given a pointer to a char data set, this will set a number of elements
  * from a provided data array to the given value. The length is determined
- * by the provided size parameter.
+ * by the provided size parameter. The elements are filled by my_memset().
  *
  * @param ptr Pointer to data array.
  * @param value Value to write to the location.
@@ -90,9 +1561,68 @@ char get_value(char * ptr, unsigned int index){
  * @return void.
  */
 void set_all(char * ptr, char value, unsigned int size){
-  unsigned int i;
-  for(i = 0; i < size; i++) {
-    set_value(ptr, i, value);
+  my_memset((uint8_t *)ptr, size, (uint8_t)value);
+}
+
+/**
+ * @brief Sets data array elements at a list of indices.
+ *
+ * Given a pointer to a char data set, this will write values[i] to index
+ * indices[i] for each of the count entries. Later entries win when an
+ * index repeats.
+ *
+ * @param ptr Pointer to data array.
+ * @param indices Indices into the data array to set.
+ * @param values Values to write, one per index.
+ * @param count Number of entries in indices and values.
+ *
+ * @return void.
+ */
+void set_values(char * ptr, const unsigned int * indices, const char * values,
+                size_t count){
+  size_t i = 0;
+
+  /* Unrolled by four; the stores stay in order for repeated indices. */
+  while((count - i) >= 4){
+    ptr[indices[i]] = values[i];
+    ptr[indices[i + 1]] = values[i + 1];
+    ptr[indices[i + 2]] = values[i + 2];
+    ptr[indices[i + 3]] = values[i + 3];
+    i += 4;
+  }
+  while(i < count){
+    ptr[indices[i]] = values[i];
+    i++;
+  }
+}
+
+/**
+ * @brief Reads data array elements at a list of indices.
+ *
+ * Given a pointer to a char data set, this will read index indices[i]
+ * into values[i] for each of the count entries.
+ *
+ * @param ptr Pointer to data array.
+ * @param indices Indices into the data array to read.
+ * @param values Array receiving the values, one per index.
+ * @param count Number of entries in indices and values.
+ *
+ * @return void.
+ */
+void get_values(char * ptr, const unsigned int * indices, char * values,
+                size_t count){
+  size_t i = 0;
+
+  while((count - i) >= 4){
+    values[i] = ptr[indices[i]];
+    values[i + 1] = ptr[indices[i + 1]];
+    values[i + 2] = ptr[indices[i + 2]];
+    values[i + 3] = ptr[indices[i + 3]];
+    i += 4;
+  }
+  while(i < count){
+    values[i] = ptr[indices[i]];
+    i++;
   }
 }
 
@@ -117,6 +1647,8 @@ void clear_all(char * ptr, unsigned int size){
  * Given two pointers to a char data set, this will move bytes
  * from the source to the destination. The behavior should handle
  * overlap of source and destination. Copy should occur, with no data corruption.
+ * The move is done in place, forwards or backwards depending on how the two
+ * regions overlap, so no temporary buffer is needed.
  *
  * @param src Pointer to source location.
  * @param dst Pointer to destination location.
@@ -125,15 +1657,19 @@ void clear_all(char * ptr, unsigned int size){
  * @return Pointer to the destination location.
  */
 uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length){
-  uint8_t index;
-  uint8_t buffer[length];
+  uintptr_t from = (uintptr_t)src;
+  uintptr_t to = (uintptr_t)dst;
 
-  for(index = 0; index < length; index++){
-    *(buffer+index) = *(src+index);
+  if((length == 0) || (from == to)){
+    return dst;
   }
 
-  for(index = 0; index < length; index++){
-    *(dst+index) = *(buffer+index);
+  /* A forward copy is safe unless dst lands inside the source span, in
+     which case walking backwards keeps unread source bytes intact. */
+  if((to < from) || ((to - from) >= length)){
+    mem_copy_fwd(dst, src, length);
+  }else{
+    mem_copy_bwd(dst, src, length);
   }
 
   return dst;
@@ -145,7 +1681,8 @@ uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length){
  * Given two pointers to a char data set, this will move bytes
  * from the source to the destination. The behavior is undefined if there
  * is overlap of source and destination. Copy should still occur, but will
- * likely corrupt the data.
+ * likely corrupt the data. The copy is done a machine word at a time with
+ * byte copies only for the unaligned head and tail.
  *
  * @param src Pointer to source location.
  * @param dst Pointer to destination location.
@@ -154,15 +1691,71 @@ uint8_t * my_memmove(uint8_t * src, uint8_t * dst, size_t length){
  * @return Pointer to the destination location.
  */
 uint8_t * my_memcopy(uint8_t * src, uint8_t * dst, size_t length){
-  uint8_t index;
+  return my_memcopy_stream(src, dst, length, MEM_STREAM_AUTO);
+}
 
-  for(index = 0; index < length; index++){
-    *(dst+index) = *(src+index);
+/**
+ * @brief Copies bytes, choosing whether the stores bypass the caches.
+ *
+ * Given two pointers to a char data set, this will copy bytes from the
+ * source to the destination like my_memcopy(). Streaming stores write the
+ * destination straight to memory so a large copy does not evict the rest
+ * of the cache.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy from the source to the destination.
+ * @param mode MEM_STREAM_AUTO, MEM_STREAM_ALWAYS or MEM_STREAM_NEVER.
+ *
+ * @return Pointer to the destination location.
+ */
+uint8_t * my_memcopy_stream(uint8_t * src, uint8_t * dst, size_t length,
+                            mem_stream_t mode){
+  if(mem_streaming(length, mode)){
+    mem_kernels.copy_stream(dst, src, length);
+  }else{
+    mem_copy_fwd(dst, src, length);
   }
 
   return dst;
 }
 
+/**
+ * @brief Copies a batch of fragments described by an array of descriptors.
+ *
+ * Given an array of count descriptors, this will copy every fragment in
+ * order in a single call. While a fragment is copied the source and
+ * destination of the one MEM_BATCH_PREFETCH descriptors ahead are
+ * prefetched, hiding the cache misses of scattered fragments. Fragments up
+ * to MEM_BATCH_SMALL bytes skip the word copy set up entirely.
+ *
+ * @param desc Pointer to the array of descriptors.
+ * @param count Number of descriptors in the array.
+ *
+ * @return Total length of bytes copied.
+ */
+size_t my_memcopy_batch(const mem_copy_desc_t * desc, size_t count){
+  size_t total = 0;
+  size_t i;
+
+  for(i = 0; i < count; i++){
+    if((i + MEM_BATCH_PREFETCH) < count){
+      MEM_PREFETCH(desc[i + MEM_BATCH_PREFETCH].src);
+      MEM_PREFETCH_WRITE(desc[i + MEM_BATCH_PREFETCH].dst);
+    }
+
+    if(desc[i].length <= MEM_BATCH_SMALL){
+      mem_copy_small(desc[i].dst, desc[i].src, desc[i].length);
+    }else{
+      my_memcopy_stream(desc[i].src, desc[i].dst, desc[i].length,
+                        MEM_STREAM_AUTO);
+    }
+    total += desc[i].length;
+  }
+
+  return total;
+}
+
 /**
  * @brief Sets bytes of memory source location with a given value.
  *
@@ -176,10 +1769,28 @@ uint8_t * my_memcopy(uint8_t * src, uint8_t * dst, size_t length){
  * @return Pointer to the source memory location.
  */
 uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value){
-  uint8_t index;
+  return my_memset_stream(src, length, value, MEM_STREAM_AUTO);
+}
 
-  for(index = 0; index < length; index++){
-    *(src+index) = value;
+/**
+ * @brief Sets bytes to a value, choosing whether the stores bypass the caches.
+ *
+ * Given pointer to source memory location, this will set bytes in the
+ * source memory location with the given value like my_memset().
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param value Value to be set in the source memory location.
+ * @param mode MEM_STREAM_AUTO, MEM_STREAM_ALWAYS or MEM_STREAM_NEVER.
+ *
+ * @return Pointer to the source memory location.
+ */
+uint8_t * my_memset_stream(uint8_t * src, size_t length, uint8_t value,
+                           mem_stream_t mode){
+  if(mem_streaming(length, mode)){
+    mem_kernels.set_stream(src, value, length);
+  }else{
+    mem_kernels.set(src, value, length);
   }
 
   return src;
@@ -197,20 +1808,81 @@ uint8_t * my_memset(uint8_t * src, size_t length, uint8_t value){
  * @return Pointer to the source memory location.
  */
 uint8_t * my_memzero(uint8_t * src, size_t length){
-  uint8_t index;
+  return my_memset_stream(src, length, 0, MEM_STREAM_AUTO);
+}
 
-  for(index = 0; index < length; index++){
-    *(src+index) = 0;
-  }
+/**
+ * @brief Copies bytes from the source to the destination on several threads.
+ *
+ * Given two pointers to a char data set, this will copy bytes from the
+ * source to the destination like my_memcopy(), splitting the work across
+ * threads. Lengths below MEM_PARALLEL_CUTOFF are copied by the caller alone.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to copy from the source to the destination.
+ * @param threads Number of threads to use, 0 for one per online CPU.
+ *
+ * @return Pointer to the destination location.
+ */
+uint8_t * my_memcopy_parallel(uint8_t * src, uint8_t * dst, size_t length,
+                              unsigned int threads){
+#if defined(HOST)
+  mem_parallel(dst, src, length, 0, threads);
+  return dst;
+#else
+  (void)threads;
+  return my_memcopy(src, dst, length);
+#endif
+}
 
+/**
+ * @brief Sets bytes of memory source location with a value on several threads.
+ *
+ * Given pointer to source memory location, this will set bytes in the
+ * source memory location with the given value like my_memset(), splitting
+ * the work across threads. Lengths below MEM_PARALLEL_CUTOFF are set by
+ * the caller alone.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param value Value to be set in the source memory location.
+ * @param threads Number of threads to use, 0 for one per online CPU.
+ *
+ * @return Pointer to the source memory location.
+ */
+uint8_t * my_memset_parallel(uint8_t * src, size_t length, uint8_t value,
+                             unsigned int threads){
+#if defined(HOST)
+  mem_parallel(src, NULL, length, value, threads);
   return src;
+#else
+  (void)threads;
+  return my_memset(src, length, value);
+#endif
+}
+
+/**
+ * @brief Sets bytes of memory source location with zeros on several threads.
+ *
+ * Same as my_memset_parallel() with a value of zero.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param threads Number of threads to use, 0 for one per online CPU.
+ *
+ * @return Pointer to the source memory location.
+ */
+uint8_t * my_memzero_parallel(uint8_t * src, size_t length, unsigned int threads){
+  return my_memset_parallel(src, length, 0, threads);
 }
 
 /**
  * @brief Reverses the order of all of the bytes in the source memory location.
  *
  * Given pointer to source memory location, this will reverse order of all of 
- * bytes in the source memory location.
+ * bytes in the source memory location. Blocks are swapped from both ends at
+ * once, with byte shuffles where the CPU has them.
  *
  * @param src Pointer to source memory location.
  * @param length Length of bytes of the source memory location.
@@ -218,48 +1890,234 @@ uint8_t * my_memzero(uint8_t * src, size_t length){
  * @return Pointer to the source memory location.
  */
 uint8_t * my_reverse(uint8_t * src, size_t length){
-  uint8_t index;
-  uint8_t temp;
-  uint8_t size = length/2;
+  mem_kernels.reverse(src, src + length, 1);
 
-  for(index = 0; index < size ; index++){
-    temp = *(src+index);
-    *(src+index) = *(src+length-index-1);
-    *(src+length-index-1) = temp;
+  return src;
+}
+
+/**
+ * @brief Reverses the order of fixed width elements in the source memory location.
+ *
+ * Given pointer to source memory location holding count elements of the
+ * given width, this will reverse the order of the elements while keeping
+ * the byte order inside each element.
+ *
+ * @param src Pointer to source memory location.
+ * @param count Number of elements in the source memory location.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return Pointer to the source memory location, or a Null Pointer if the
+ *         width is not supported.
+ */
+uint8_t * my_reverse_elements(uint8_t * src, size_t count, size_t width){
+  if(mem_width_shift(width) < 0){
+    return NULL;
   }
 
+  mem_kernels.reverse(src, src + (count * width), width);
+
   return src;
 }
 
+/**
+ * @brief Byte swaps fixed width elements from the source to the destination.
+ *
+ * Given two pointers to data sets of count elements of the given width,
+ * this will write every source element to the destination with its bytes
+ * reversed, converting between big and little endian in a single pass.
+ * Source and destination may be the same buffer but must not otherwise
+ * overlap.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param count Number of elements to convert.
+ * @param width Element width in bytes: 1, 2, 4 or 8.
+ *
+ * @return Pointer to the destination location, or a Null Pointer if the
+ *         width is not supported.
+ */
+uint8_t * my_byteswap(uint8_t * src, uint8_t * dst, size_t count, size_t width){
+  if(mem_width_shift(width) < 0){
+    return NULL;
+  }
+
+  if(width == 1){
+    if(dst != src){
+      my_memcopy(src, dst, count);
+    }
+  }else{
+    mem_kernels.bswap(dst, src, count * width, width);
+  }
+
+  return dst;
+}
+
+/**
+ * @brief Compares bytes of two memory locations.
+ *
+ * Given two pointers to a char data set, this will compare length bytes
+ * as unsigned values, the way memcmp() does. The regions are scanned a
+ * vector at a time where the CPU allows it.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to compare.
+ *
+ * @return Zero if the regions are equal, otherwise the difference between
+ *         the first pair of bytes that differ, source minus destination.
+ */
+int my_memcmp(uint8_t * src, uint8_t * dst, size_t length){
+  size_t index = mem_kernels.diff(src, dst, length);
+
+  if(index == length){
+    return 0;
+  }
+  return (int)src[index] - (int)dst[index];
+}
+
+/**
+ * @brief Finds the first difference between two memory locations.
+ *
+ * @param src Pointer to source location.
+ * @param dst Pointer to destination location.
+ * @param length Length of bytes to compare.
+ *
+ * @return Index of the first byte that differs, or length if the regions
+ *         are equal.
+ */
+size_t my_memdiff(uint8_t * src, uint8_t * dst, size_t length){
+  return mem_kernels.diff(src, dst, length);
+}
+
+/**
+ * @brief Finds the first occurrence of a byte value in a memory location.
+ *
+ * Given pointer to source memory location, this will search the first
+ * length bytes for the given value, a vector at a time where the CPU
+ * allows it.
+ *
+ * @param src Pointer to source memory location.
+ * @param length Length of bytes of the source memory location.
+ * @param value Value to search for.
+ *
+ * @return Pointer to the first matching byte, or a Null Pointer if the
+ *         value does not occur.
+ */
+uint8_t * my_memchr(uint8_t * src, size_t length, uint8_t value){
+  size_t index = mem_kernels.find(src, value, length);
+
+  return (index < length) ? (src + index) : NULL;
+}
+
 /**
  * @brief Allocates dynamic memory.
  *
- * Given number of word to be allocated in dynamic memory.
+ * Given number of word to be allocated in dynamic memory. Small requests
+ * are popped off a size class free list of the block pool, larger ones
+ * come from the heap.
  * 
  * @param length Length of bytes of the source memory location.
  *
  * @return Pointer to the source memory location if successful, or a 
  *         Null Pointer if not successful.
  */
-int32_t * reserve_words(size_t length){
-  if(length > 0)
-  {
-    int32_t * ptr = (int32_t *)malloc(sizeof(int32_t) * length);
-    return ptr;
-  }else{
-    return NULL;
-  }
+int32_t * (reserve_words)(size_t length){
+  return reserve_aligned_at(length, sizeof(int32_t), NULL, 0);
 }
 
 /**
  * @brief Frees the dynamic memory location.
  *
- * Given pointer to memory location, this function will free this dynamic memory location.
+ * Given pointer to memory location, this function will free this dynamic
+ * memory location, returning pool blocks to their free list.
  *
  * @param src Pointer to source memory location.
  *
  * @return void.
  */
 void free_words(uint32_t * src){
-  free(src);
+#if defined(MEM_STATS)
+  if(src != NULL){
+    mem_stats_free(pool_size(src), pool_tag(src));
+  }
+#endif
+  pool_free(src);
+}
+
+/**
+ * @brief Allocates dynamic memory on an alignment boundary.
+ *
+ * Given number of words to be allocated and a power of two alignment, this
+ * reserves the words from the block pool with the first word on the
+ * boundary. MEM_ALIGN_PAGE aligns to the page size, and alignments below a
+ * word give word aligned memory like reserve_words().
+ *
+ * @param length Number of words to allocate.
+ * @param alignment Alignment in bytes, or MEM_ALIGN_PAGE.
+ *
+ * @return Pointer to the aligned memory if successful, or a Null Pointer
+ *         if not successful or the alignment is not a power of two.
+ */
+int32_t * (reserve_aligned)(size_t length, size_t alignment){
+  return reserve_aligned_at(length, alignment, NULL, 0);
+}
+
+/**
+ * @brief Allocates aligned dynamic memory on behalf of a call site.
+ *
+ * Common implementation of reserve_words() and reserve_aligned(). The call
+ * site is only used when the build records allocator statistics.
+ *
+ * @param length Number of words to allocate.
+ * @param alignment Alignment in bytes, or MEM_ALIGN_PAGE.
+ * @param file Source file of the call, or a Null Pointer.
+ * @param line Source line of the call.
+ *
+ * @return Pointer to the aligned memory if successful, or a Null Pointer
+ *         if not successful or the alignment is not a power of two.
+ */
+int32_t * reserve_aligned_at(size_t length, size_t alignment,
+                             const char * file, unsigned int line){
+  int32_t * ptr = NULL;
+
+  if(alignment == MEM_ALIGN_PAGE){
+#if defined(HOST)
+    long page = sysconf(_SC_PAGESIZE);
+    alignment = (page > 0) ? (size_t)page : MEM_PAGE_SIZE;
+#else
+    alignment = MEM_PAGE_SIZE;
+#endif
+  }
+
+  /* The pool refuses alignments that are not a power of two and rounds
+     smaller ones up to its own block alignment, which covers a word. */
+  if((length > 0) && (length <= (SIZE_MAX / sizeof(int32_t)))){
+    ptr = (int32_t *)pool_alloc_aligned(sizeof(int32_t) * length, alignment);
+  }
+
+#if defined(MEM_STATS)
+  if(length > 0){
+    uint16_t site = mem_stats_alloc(sizeof(int32_t) * length, ptr != NULL,
+                                    file, line);
+    if(ptr != NULL){
+      pool_set_tag(ptr, site);
+    }
+  }
+#else
+  (void)file;
+  (void)line;
+#endif
+
+  return ptr;
+}
+
+/**
+ * @brief Frees memory reserved by reserve_aligned().
+ *
+ * @param src Pointer to the aligned memory location.
+ *
+ * @return void.
+ */
+void free_aligned(uint32_t * src){
+  free_words(src);
 }
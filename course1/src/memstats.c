@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file memstats.c
+ * @brief Allocation counters for the word allocator
+ *
+ * Counters are size_t wide and updated with relaxed atomics, which are
+ * plain load/store-exclusive sequences on the Cortex-M4 and single locked
+ * instructions on the host. Call sites live in a small open addressed
+ * table keyed by file and line; a new site takes a spinlock once, every
+ * later hit is lock free.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#include "../include/common/memstats.h"
+#include "../include/common/platform.h"
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+static mem_stats_t mem_stats;
+
+/* Serialises claiming a free site slot. */
+static volatile char mem_stats_locked;
+
+#define MEM_STATS_ADD(counter, value) \
+  __atomic_fetch_add(&(counter), (value), __ATOMIC_RELAXED)
+#define MEM_STATS_SUB(counter, value) \
+  __atomic_fetch_sub(&(counter), (value), __ATOMIC_RELAXED)
+
+/**
+ * @brief Finds or claims the table slot of a call site.
+ *
+ * @param file Source file of the call.
+ * @param line Source line of the call.
+ *
+ * @return Slot index, or MEM_STATS_NO_SITE if the table is full.
+ */
+static uint16_t mem_stats_site(const char * file, unsigned int line){
+  unsigned int start = (unsigned int)(((uintptr_t)file >> 3) ^ (line * 2654435761u)) %
+                       MEM_STATS_SITES;
+  unsigned int probe;
+  unsigned int index;
+  const char * owner;
+
+  for(probe = 0; probe < MEM_STATS_SITES; probe++){
+    index = (start + probe) % MEM_STATS_SITES;
+    owner = __atomic_load_n(&mem_stats.sites[index].file, __ATOMIC_ACQUIRE);
+
+    if(owner == NULL){
+      /* Claim the slot under the lock, unless another thread got it first. */
+      while(__atomic_test_and_set(&mem_stats_locked, __ATOMIC_ACQUIRE)) { }
+      owner = mem_stats.sites[index].file;
+      if(owner == NULL){
+        mem_stats.sites[index].line = line;
+        __atomic_store_n(&mem_stats.sites[index].file, file, __ATOMIC_RELEASE);
+        owner = file;
+      }
+      __atomic_clear(&mem_stats_locked, __ATOMIC_RELEASE);
+    }
+
+    if((owner == file) && (mem_stats.sites[index].line == line)){
+      return (uint16_t)index;
+    }
+  }
+  return MEM_STATS_NO_SITE;
+}
+
+/**
+ * @brief Histogram bucket of a request size.
+ */
+static unsigned int mem_stats_bucket(size_t size){
+  unsigned int bucket = 0;
+
+  while((size > 1) && (bucket < (MEM_STATS_BUCKETS - 1))){
+    size >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+uint16_t mem_stats_alloc(size_t size, int ok, const char * file, unsigned int line){
+  size_t live;
+  size_t peak;
+  uint16_t site = MEM_STATS_NO_SITE;
+
+  if(! ok){
+    MEM_STATS_ADD(mem_stats.failures, 1);
+    return site;
+  }
+
+  MEM_STATS_ADD(mem_stats.allocs, 1);
+  MEM_STATS_ADD(mem_stats.histogram[mem_stats_bucket(size)], 1);
+  live = MEM_STATS_ADD(mem_stats.live_bytes, size) + size;
+
+  peak = __atomic_load_n(&mem_stats.peak_bytes, __ATOMIC_RELAXED);
+  while((live > peak) &&
+        ! __atomic_compare_exchange_n(&mem_stats.peak_bytes, &peak, live, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+  }
+
+  if(file != NULL){
+    site = mem_stats_site(file, line);
+    if(site != MEM_STATS_NO_SITE){
+      MEM_STATS_ADD(mem_stats.sites[site].allocs, 1);
+      MEM_STATS_ADD(mem_stats.sites[site].live_bytes, size);
+    }
+  }
+  return site;
+}
+
+void mem_stats_free(size_t size, uint16_t site){
+  MEM_STATS_ADD(mem_stats.frees, 1);
+  MEM_STATS_SUB(mem_stats.live_bytes, size);
+
+  if(site < MEM_STATS_SITES){
+    MEM_STATS_ADD(mem_stats.sites[site].frees, 1);
+    MEM_STATS_SUB(mem_stats.sites[site].live_bytes, size);
+  }
+}
+
+void mem_stats_snapshot(mem_stats_t * out){
+  unsigned int i;
+
+  out->allocs = __atomic_load_n(&mem_stats.allocs, __ATOMIC_RELAXED);
+  out->frees = __atomic_load_n(&mem_stats.frees, __ATOMIC_RELAXED);
+  out->failures = __atomic_load_n(&mem_stats.failures, __ATOMIC_RELAXED);
+  out->live_bytes = __atomic_load_n(&mem_stats.live_bytes, __ATOMIC_RELAXED);
+  out->peak_bytes = __atomic_load_n(&mem_stats.peak_bytes, __ATOMIC_RELAXED);
+
+  for(i = 0; i < MEM_STATS_BUCKETS; i++){
+    out->histogram[i] = __atomic_load_n(&mem_stats.histogram[i], __ATOMIC_RELAXED);
+  }
+
+  for(i = 0; i < MEM_STATS_SITES; i++){
+    out->sites[i].file = __atomic_load_n(&mem_stats.sites[i].file, __ATOMIC_ACQUIRE);
+    out->sites[i].line = mem_stats.sites[i].line;
+    out->sites[i].allocs = __atomic_load_n(&mem_stats.sites[i].allocs, __ATOMIC_RELAXED);
+    out->sites[i].frees = __atomic_load_n(&mem_stats.sites[i].frees, __ATOMIC_RELAXED);
+    out->sites[i].live_bytes = __atomic_load_n(&mem_stats.sites[i].live_bytes,
+                                               __ATOMIC_RELAXED);
+  }
+}
+
+void mem_stats_reset(void){
+  size_t live;
+  unsigned int i;
+
+  while(__atomic_test_and_set(&mem_stats_locked, __ATOMIC_ACQUIRE)) { }
+
+  /* Live bytes and sites describe blocks that are still out; clearing
+     them would make the frees of those blocks underflow. */
+  live = __atomic_load_n(&mem_stats.live_bytes, __ATOMIC_RELAXED);
+  __atomic_store_n(&mem_stats.allocs, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&mem_stats.frees, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&mem_stats.failures, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&mem_stats.peak_bytes, live, __ATOMIC_RELAXED);
+  for(i = 0; i < MEM_STATS_BUCKETS; i++){
+    __atomic_store_n(&mem_stats.histogram[i], 0, __ATOMIC_RELAXED);
+  }
+  for(i = 0; i < MEM_STATS_SITES; i++){
+    __atomic_store_n(&mem_stats.sites[i].allocs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&mem_stats.sites[i].frees, 0, __ATOMIC_RELAXED);
+  }
+
+  __atomic_clear(&mem_stats_locked, __ATOMIC_RELEASE);
+}
+
+void mem_stats_print(void){
+  mem_stats_t snap;
+  unsigned int i;
+
+  mem_stats_snapshot(&snap);
+
+  PRINTF("mem_stats,allocs,%lu\n", (unsigned long)snap.allocs);
+  PRINTF("mem_stats,frees,%lu\n", (unsigned long)snap.frees);
+  PRINTF("mem_stats,failures,%lu\n", (unsigned long)snap.failures);
+  PRINTF("mem_stats,live_bytes,%lu\n", (unsigned long)snap.live_bytes);
+  PRINTF("mem_stats,peak_bytes,%lu\n", (unsigned long)snap.peak_bytes);
+
+  for(i = 0; i < MEM_STATS_BUCKETS; i++){
+    if(snap.histogram[i] != 0){
+      PRINTF("mem_stats,size_2^%u,%lu\n", i, (unsigned long)snap.histogram[i]);
+    }
+  }
+
+  for(i = 0; i < MEM_STATS_SITES; i++){
+    if(snap.sites[i].file != NULL){
+      PRINTF("mem_stats,site,%s:%u,%lu,%lu,%lu\n", snap.sites[i].file,
+             snap.sites[i].line, (unsigned long)snap.sites[i].allocs,
+             (unsigned long)snap.sites[i].frees,
+             (unsigned long)snap.sites[i].live_bytes);
+    }
+  }
+}
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file mpmc.c
+ * @brief Bounded lock-free multi producer, multi consumer queue
+ *
+ * Slot i starts with sequence i. A producer at position p may fill slot
+ * p & mask once its sequence equals p, and then sets it to p + 1. A
+ * consumer at position p may empty the slot once its sequence equals
+ * p + 1, and then sets it to p + capacity, ready for the producer of the
+ * next lap. Positions are claimed with a compare and swap, so a thread
+ * that loses the race simply retries at the new position.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#include "../include/common/mpmc.h"
+#include "../include/common/memory.h"
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+#if defined (HOST)
+#define MPMC_CACHE_LINE (64)  /* Spacing of the producer and consumer fields */
+#else
+#define MPMC_CACHE_LINE (4)   /* The MSP432 has no data cache to share */
+#endif
+
+typedef struct {
+  size_t sequence;  /* Position this slot is waiting for, see above */
+  void * item;      /* Pointer stored by the producer */
+} mpmc_slot_t;
+
+struct mpmc {
+  mpmc_slot_t * slots;  /* Slot array following the header */
+  size_t mask;          /* Capacity - 1 */
+  size_t enqueue __attribute__((aligned(MPMC_CACHE_LINE)));  /* Next push */
+  size_t dequeue __attribute__((aligned(MPMC_CACHE_LINE)));  /* Next pop */
+};
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+mpmc_t * mpmc_create(size_t capacity){
+  mpmc_t * queue;
+  size_t rounded = MPMC_MIN_CAPACITY;
+  size_t i;
+
+  while(rounded < capacity){
+    if(rounded > ((SIZE_MAX - sizeof(mpmc_t) - sizeof(int32_t)) /
+                   sizeof(mpmc_slot_t) / 2)){
+      return NULL;
+    }
+    rounded <<= 1;
+  }
+
+  queue = (mpmc_t *)reserve_aligned((sizeof(mpmc_t) +
+                                     (rounded * sizeof(mpmc_slot_t)) +
+                                     sizeof(int32_t) - 1) / sizeof(int32_t),
+                                    MPMC_CACHE_LINE);
+  if(queue == NULL){
+    return NULL;
+  }
+
+  queue->slots = (mpmc_slot_t *)((uint8_t *)queue + sizeof(mpmc_t));
+  queue->mask = rounded - 1;
+  for(i = 0; i < rounded; i++){
+    queue->slots[i].sequence = i;
+    queue->slots[i].item = NULL;
+  }
+  queue->enqueue = 0;
+  queue->dequeue = 0;
+  return queue;
+}
+
+void mpmc_destroy(mpmc_t * queue){
+  free_aligned((uint32_t *)queue);
+}
+
+int mpmc_push(mpmc_t * queue, void * item){
+  size_t position = __atomic_load_n(&queue->enqueue, __ATOMIC_RELAXED);
+  mpmc_slot_t * slot;
+  size_t sequence;
+  intptr_t lap;
+
+  for(;;){
+    slot = &queue->slots[position & queue->mask];
+    sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    lap = (intptr_t)(sequence - position);
+
+    if(lap == 0){
+      /* Free for this lap; a failed claim reloads position */
+      if(__atomic_compare_exchange_n(&queue->enqueue, &position, position + 1,
+                                     1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+        break;
+      }
+    }else if(lap < 0){
+      /* Still holding last lap's item */
+      return 0;
+    }else{
+      position = __atomic_load_n(&queue->enqueue, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->item = item;
+  __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+int mpmc_pop(mpmc_t * queue, void ** item){
+  size_t position = __atomic_load_n(&queue->dequeue, __ATOMIC_RELAXED);
+  mpmc_slot_t * slot;
+  size_t sequence;
+  intptr_t lap;
+
+  for(;;){
+    slot = &queue->slots[position & queue->mask];
+    sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    lap = (intptr_t)(sequence - (position + 1));
+
+    if(lap == 0){
+      if(__atomic_compare_exchange_n(&queue->dequeue, &position, position + 1,
+                                     1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+        break;
+      }
+    }else if(lap < 0){
+      /* Not yet filled in this lap */
+      return 0;
+    }else{
+      position = __atomic_load_n(&queue->dequeue, __ATOMIC_RELAXED);
+    }
+  }
+
+  *item = slot->item;
+  __atomic_store_n(&slot->sequence, position + queue->mask + 1,
+                   __ATOMIC_RELEASE);
+  return 1;
+}
+
+size_t mpmc_capacity(const mpmc_t * queue){
+  return queue->mask + 1;
+}
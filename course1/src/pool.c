@@ -0,0 +1,630 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file pool.c
+ * @brief Fixed size block pool backing the word allocator
+ *
+ * Every payload is preceded by a POOL_HEADER_SIZE header recording its
+ * size class and its offset into the block, so pool_free() finds the right
+ * free list and block start without a search.
+ *
+ * Each thread keeps its own cache of free blocks per size class, so most
+ * allocate/free pairs never touch shared state. Caches are refilled from
+ * and drained to a shared depot POOL_CACHE_BATCH blocks at a time, and a
+ * thread's cache is handed back to the depot when the thread exits. On the
+ * host the depot and slab carving sit behind one spinlock, which only
+ * refills, drains and pool_class_stats() take. Free blocks are linked
+ * through their first word. Slabs are kept for the life
+ * of the program; their blocks are recycled but never handed back.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#if defined (HOST)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdlib.h>
+#include "../include/common/pool.h"
+
+#if defined (HOST)
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#endif
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+/**
+ * @brief Header stored in front of every payload.
+ */
+typedef union {
+  struct {
+    uint16_t size_class;  /* Index into the free lists, or a POOL_CLASS_ backing */
+    uint16_t tag;         /* Caller defined, see pool_set_tag() */
+    uint32_t offset;      /* Bytes from the start of the block to the payload */
+    size_t size;          /* Bytes requested by the caller */
+  } info;
+  uint8_t pad[POOL_HEADER_SIZE];
+} pool_header_t;
+
+/**
+ * @brief Free block, linked through its first word.
+ */
+typedef struct pool_block {
+  struct pool_block * next;
+} pool_block_t;
+
+/**
+ * @brief Per thread stash of free blocks, one list per size class.
+ */
+typedef struct {
+  pool_block_t * head[POOL_CLASS_COUNT];
+  unsigned int count[POOL_CLASS_COUNT];
+} pool_cache_t;
+
+/* Shared depot of free blocks, one list per size class. Threads only visit
+   it to move POOL_CACHE_BATCH blocks in or out of their own cache. */
+static pool_block_t * pool_free_lists[POOL_CLASS_COUNT];
+
+/* Guards the depot on the host, where several threads may allocate. The
+   MSP432 build is single threaded and needs neither lock nor TLS. */
+#if defined (HOST)
+static volatile char pool_locked;
+static pthread_key_t pool_cache_key;
+static pthread_once_t pool_cache_once = PTHREAD_ONCE_INIT;
+static __thread int pool_cache_registered;
+
+#if defined (__x86_64__) || defined (__i386__)
+#define POOL_PAUSE()  __builtin_ia32_pause()
+#else
+#define POOL_PAUSE()  sched_yield()
+#endif
+
+/* Waiters spin on a plain load so the line stays shared until the holder
+   releases it, pausing between reads. */
+#define POOL_THREAD   __thread
+#define POOL_LOCK() \
+  while(__atomic_test_and_set(&pool_locked, __ATOMIC_ACQUIRE)) { \
+    while(__atomic_load_n(&pool_locked, __ATOMIC_RELAXED)) { \
+      POOL_PAUSE(); \
+    } \
+  }
+#define POOL_UNLOCK() __atomic_clear(&pool_locked, __ATOMIC_RELEASE)
+#else
+#define POOL_THREAD
+#define POOL_LOCK()
+#define POOL_UNLOCK()
+#endif
+
+/* Free blocks owned by the calling thread. */
+static POOL_THREAD pool_cache_t pool_cache;
+
+/* Blocks carved from slabs so far, per size class. */
+static size_t pool_carved[POOL_CLASS_COUNT];
+
+/* Huge page policy for large requests, see pool_set_huge_mode(). */
+static pool_huge_t pool_huge_mode = POOL_HUGE_MODE;
+static size_t pool_huge_threshold = POOL_HUGE_THRESHOLD;
+
+/**
+ * @brief Finds the smallest size class holding a block plus header.
+ *
+ * @param size Number of payload bytes requested.
+ *
+ * @return Size class index, or POOL_CLASS_LARGE if no class is big enough.
+ */
+static unsigned int pool_class_of(size_t size){
+  size_t block = POOL_MIN_BLOCK;
+  unsigned int index;
+
+  if(size > (POOL_MAX_BLOCK - POOL_HEADER_SIZE)){
+    return POOL_CLASS_LARGE;
+  }
+
+  for(index = 0; block < (size + POOL_HEADER_SIZE); index++){
+    block <<= 1;
+  }
+  return index;
+}
+
+/**
+ * @brief Carves a new slab into blocks of one size class.
+ *
+ * Called with the lock held when the free list of the class is empty.
+ *
+ * @param index Size class to refill.
+ *
+ * @return Non-zero if the free list now holds blocks.
+ */
+static int pool_refill(unsigned int index){
+  size_t block = (size_t)POOL_MIN_BLOCK << index;
+  size_t count = POOL_SLAB_SIZE / block;
+  uint8_t * slab;
+  size_t i;
+
+  if(count == 0){
+    count = 1;
+  }
+
+  /* malloc only promises 8 byte alignment on the MSP432, so leave room to
+     start the first block on a POOL_HEADER_SIZE boundary. */
+  slab = (uint8_t *)malloc((count * block) + POOL_HEADER_SIZE);
+  if(slab == NULL){
+    return 0;
+  }
+  slab = (uint8_t *)(((uintptr_t)slab + POOL_HEADER_SIZE - 1) &
+                     ~(uintptr_t)(POOL_HEADER_SIZE - 1));
+
+  for(i = 0; i < count; i++){
+    pool_block_t * free_block = (pool_block_t *)(slab + (i * block));
+    free_block->next = pool_free_lists[index];
+    pool_free_lists[index] = free_block;
+  }
+  pool_carved[index] += count;
+  return 1;
+}
+
+/**
+ * @brief Moves blocks from the depot into the calling thread's cache.
+ *
+ * Takes up to POOL_CACHE_BATCH blocks under the lock, carving a new slab
+ * first if the depot is empty.
+ *
+ * @param index Size class to refill.
+ *
+ * @return Non-zero if the cache now holds blocks.
+ */
+static int pool_cache_fill(unsigned int index){
+  pool_block_t * first;
+  pool_block_t * last;
+  unsigned int moved = 1;
+
+  POOL_LOCK();
+  if((pool_free_lists[index] == NULL) && (! pool_refill(index))){
+    POOL_UNLOCK();
+    return 0;
+  }
+
+  first = pool_free_lists[index];
+  last = first;
+  while((moved < POOL_CACHE_BATCH) && (last->next != NULL)){
+    last = last->next;
+    moved++;
+  }
+  pool_free_lists[index] = last->next;
+  POOL_UNLOCK();
+
+  last->next = pool_cache.head[index];
+  pool_cache.head[index] = first;
+  pool_cache.count[index] += moved;
+  return 1;
+}
+
+/**
+ * @brief Moves blocks from a cache back to the depot.
+ *
+ * The batch is unlinked from the cache first, so the lock is only held
+ * for the splice.
+ *
+ * @param cache Cache to drain.
+ * @param index Size class to drain.
+ * @param limit Largest number of blocks to move.
+ *
+ * @return void.
+ */
+static void pool_cache_drain(pool_cache_t * cache, unsigned int index,
+                             unsigned int limit){
+  pool_block_t * first = cache->head[index];
+  pool_block_t * last = first;
+  unsigned int moved = 1;
+
+  if((first == NULL) || (limit == 0)){
+    return;
+  }
+
+  while((moved < limit) && (last->next != NULL)){
+    last = last->next;
+    moved++;
+  }
+  cache->head[index] = last->next;
+  cache->count[index] -= moved;
+
+  POOL_LOCK();
+  last->next = pool_free_lists[index];
+  pool_free_lists[index] = first;
+  POOL_UNLOCK();
+}
+
+#if defined (HOST)
+/**
+ * @brief Returns every block of an exiting thread's cache to the depot.
+ *
+ * @param arg Pointer to the thread's pool_cache_t.
+ *
+ * @return void.
+ */
+static void pool_cache_release(void * arg){
+  pool_cache_t * cache = (pool_cache_t *)arg;
+  unsigned int index;
+
+  for(index = 0; index < POOL_CLASS_COUNT; index++){
+    pool_cache_drain(cache, index, cache->count[index]);
+  }
+}
+
+/**
+ * @brief Creates the key whose destructor drains exiting threads.
+ */
+static void pool_cache_key_create(void){
+  pthread_key_create(&pool_cache_key, pool_cache_release);
+}
+
+/**
+ * @brief Arranges for the calling thread's cache to be drained on exit.
+ */
+static void pool_cache_register(void){
+  pthread_once(&pool_cache_once, pool_cache_key_create);
+  pthread_setspecific(pool_cache_key, &pool_cache);
+  pool_cache_registered = 1;
+}
+#endif
+
+/**
+ * @brief Returns the calling thread's cache, ready for use.
+ *
+ * Every path that puts blocks in a cache goes through here first, so a
+ * thread is registered for the exit drain before its cache can hold
+ * anything, whether it allocates, frees or both.
+ *
+ * @return Pointer to the calling thread's cache.
+ */
+static pool_cache_t * pool_cache_enter(void){
+#if defined (HOST)
+  if(! pool_cache_registered){
+    pool_cache_register();
+  }
+#endif
+  return &pool_cache;
+}
+
+#if defined (HOST)
+/**
+ * @brief Reads a size from a kernel file once and caches it.
+ *
+ * @param cache Pointer to the cached value, 0 until first read.
+ * @param path File to read.
+ * @param key Prefix of the line holding the number, "" for the first line.
+ * @param scale Bytes per unit of the number.
+ *
+ * @return Size in bytes, or POOL_HUGE_PAGE if the file has no power of two
+ *         size under that key.
+ */
+static size_t pool_kernel_size(size_t * cache, const char * path,
+                               const char * key, size_t scale){
+  size_t size = __atomic_load_n(cache, __ATOMIC_RELAXED);
+  size_t length = strlen(key);
+  unsigned long value;
+  char line[128];
+  FILE * file;
+
+  if(size != 0){
+    return size;
+  }
+
+  size = POOL_HUGE_PAGE;
+  file = fopen(path, "r");
+  if(file != NULL){
+    while(fgets(line, sizeof(line), file) != NULL){
+      if((strncmp(line, key, length) == 0) &&
+         (sscanf(line + length, "%lu", &value) == 1)){
+        if((value != 0) && ((value & (value - 1)) == 0) &&
+           (value <= (SIZE_MAX / scale))){
+          size = (size_t)value * scale;
+        }
+        break;
+      }
+    }
+    fclose(file);
+  }
+
+  /* Every thread reads the same answer, so a race only repeats the read. */
+  __atomic_store_n(cache, size, __ATOMIC_RELAXED);
+  return size;
+}
+
+/**
+ * @brief Default hugetlbfs page size, which MAP_HUGETLB lengths must fill.
+ *
+ * @return Size in bytes from /proc/meminfo, or POOL_HUGE_PAGE.
+ */
+static size_t pool_hugetlb_page(void){
+  static size_t size;
+
+  return pool_kernel_size(&size, "/proc/meminfo", "Hugepagesize:", 1024);
+}
+
+/**
+ * @brief Transparent huge page size, the alignment THP mappings need.
+ *
+ * @return Size in bytes from sysfs, or POOL_HUGE_PAGE.
+ */
+static size_t pool_thp_page(void){
+  static size_t size;
+
+  return pool_kernel_size(&size, "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+                          "", 1);
+}
+
+/**
+ * @brief Bytes mapped for a huge page backed block.
+ *
+ * @param offset Bytes from the start of the mapping to the payload.
+ * @param size Bytes requested by the caller.
+ * @param page Huge page size of the mapping.
+ *
+ * @return Mapping length, a whole number of huge pages, or 0 on overflow.
+ */
+static size_t pool_huge_length(size_t offset, size_t size, size_t page){
+  if(size > (SIZE_MAX - offset - page)){
+    return 0;
+  }
+  return (offset + size + page - 1) & ~(size_t)(page - 1);
+}
+
+/**
+ * @brief Maps huge page backed memory for a large request.
+ *
+ * Explicit mode asks for hugetlbfs pages first, with the length rounded
+ * to the default hugetlbfs page size. Both modes then try an anonymous
+ * mapping aligned to the transparent huge page size and advised for
+ * transparent huge pages. Returns NULL when neither works, leaving the
+ * caller to fall back to the heap.
+ *
+ * @param offset Bytes from the start of the mapping to the payload.
+ * @param size Bytes requested by the caller.
+ * @param alignment Payload alignment, at most the transparent huge page size.
+ * @param size_class Set to the POOL_CLASS_ value of the backing obtained.
+ *
+ * @return Pointer to the mapping, or a Null Pointer.
+ */
+static uint8_t * pool_huge_map(size_t offset, size_t size, size_t alignment,
+                               uint16_t * size_class){
+  size_t page = pool_thp_page();
+  size_t length;
+  uint8_t * region;
+  uint8_t * aligned;
+  size_t head;
+
+#if defined (MAP_HUGETLB)
+  if((pool_huge_mode == POOL_HUGE_EXPLICIT) &&
+     (alignment <= pool_hugetlb_page())){
+    length = pool_huge_length(offset, size, pool_hugetlb_page());
+    region = (length == 0) ? (uint8_t *)MAP_FAILED :
+             (uint8_t *)mmap(NULL, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(region != (uint8_t *)MAP_FAILED){
+      *size_class = POOL_CLASS_HUGETLB;
+      return region;
+    }
+  }
+#else
+  (void)alignment;
+#endif
+
+  /* Over-map by one huge page and trim so the block starts on a boundary
+     the kernel can back with a single huge page. */
+  length = pool_huge_length(offset, size, page);
+  if((length == 0) || (length > (SIZE_MAX - page))){
+    return NULL;
+  }
+  region = (uint8_t *)mmap(NULL, length + page, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(region == (uint8_t *)MAP_FAILED){
+    return NULL;
+  }
+
+  aligned = (uint8_t *)(((uintptr_t)region + page - 1) & ~(uintptr_t)(page - 1));
+  head = (size_t)(aligned - region);
+  if(head > 0){
+    munmap(region, head);
+  }
+  munmap(aligned + length, page - head);
+
+#if defined (MADV_HUGEPAGE)
+  madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+  *size_class = POOL_CLASS_THP;
+  return aligned;
+}
+#endif /* HOST */
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+void * pool_alloc(size_t size){
+  return pool_alloc_aligned(size, POOL_HEADER_SIZE);
+}
+
+void * pool_alloc_aligned(size_t size, size_t alignment){
+  unsigned int index;
+  uint8_t * block;
+  uint8_t * payload;
+  pool_header_t * header;
+  pool_cache_t * cache;
+  size_t total;
+
+  if((alignment == 0) || ((alignment & (alignment - 1)) != 0) ||
+     (alignment > POOL_MAX_ALIGN)){
+    return NULL;
+  }
+  if(alignment < POOL_HEADER_SIZE){
+    alignment = POOL_HEADER_SIZE;
+  }
+
+  /* Pool blocks are POOL_HEADER_SIZE aligned, so larger alignments need
+     room to slide the payload up to the next boundary. */
+  if(size > (SIZE_MAX - alignment)){
+    return NULL;
+  }
+  total = size + (alignment - POOL_HEADER_SIZE);
+  index = pool_class_of(total);
+
+  if(index == POOL_CLASS_LARGE){
+    block = NULL;
+
+#if defined (HOST)
+    if((pool_huge_mode != POOL_HUGE_OFF) && (size >= pool_huge_threshold) &&
+       (alignment <= pool_thp_page())){
+      uint16_t backing;
+      size_t offset = (POOL_HEADER_SIZE + alignment - 1) & ~(alignment - 1);
+
+      block = pool_huge_map(offset, size, alignment, &backing);
+      if(block != NULL){
+        index = backing;
+      }
+    }
+#endif
+
+    if(block == NULL){
+      /* Heap blocks carry no alignment promise beyond malloc's own, so
+         allow for sliding a full POOL_HEADER_SIZE further. */
+      if(total > (SIZE_MAX - (2 * POOL_HEADER_SIZE))){
+        return NULL;
+      }
+      block = (uint8_t *)malloc(total + (2 * POOL_HEADER_SIZE) - 1);
+      if(block == NULL){
+        return NULL;
+      }
+    }
+  }else{
+    cache = pool_cache_enter();
+    if((cache->head[index] == NULL) && (! pool_cache_fill(index))){
+      return NULL;
+    }
+    block = (uint8_t *)cache->head[index];
+    cache->head[index] = cache->head[index]->next;
+    cache->count[index]--;
+  }
+
+  payload = (uint8_t *)(((uintptr_t)block + POOL_HEADER_SIZE + alignment - 1) &
+                        ~(uintptr_t)(alignment - 1));
+  header = (pool_header_t *)(payload - POOL_HEADER_SIZE);
+  header->info.size_class = (uint16_t)index;
+  header->info.tag = 0;
+  header->info.offset = (uint32_t)(payload - block);
+  header->info.size = size;
+  return payload;
+}
+
+void pool_free(void * ptr){
+  pool_header_t * header;
+  pool_cache_t * cache;
+  pool_block_t * block;
+  unsigned int index;
+
+  if(ptr == NULL){
+    return;
+  }
+
+  header = (pool_header_t *)((uint8_t *)ptr - POOL_HEADER_SIZE);
+  index = header->info.size_class;
+  block = (pool_block_t *)((uint8_t *)ptr - header->info.offset);
+
+  if(index == POOL_CLASS_LARGE){
+    free(block);
+    return;
+  }
+
+#if defined (HOST)
+  if((index == POOL_CLASS_THP) || (index == POOL_CLASS_HUGETLB)){
+    munmap(block, pool_huge_length(header->info.offset, header->info.size,
+                                   (index == POOL_CLASS_HUGETLB) ?
+                                   pool_hugetlb_page() : pool_thp_page()));
+    return;
+  }
+#endif
+
+  cache = pool_cache_enter();
+  block->next = cache->head[index];
+  cache->head[index] = block;
+  cache->count[index]++;
+
+  if(cache->count[index] > POOL_CACHE_LIMIT){
+    pool_cache_drain(cache, index, POOL_CACHE_BATCH);
+  }
+}
+
+size_t pool_size(const void * ptr){
+  return ((const pool_header_t *)((const uint8_t *)ptr - POOL_HEADER_SIZE))->info.size;
+}
+
+uint16_t pool_tag(const void * ptr){
+  return ((const pool_header_t *)((const uint8_t *)ptr - POOL_HEADER_SIZE))->info.tag;
+}
+
+void pool_set_tag(void * ptr, uint16_t tag){
+  ((pool_header_t *)((uint8_t *)ptr - POOL_HEADER_SIZE))->info.tag = tag;
+}
+
+void pool_set_huge_mode(pool_huge_t mode, size_t threshold){
+  pool_huge_mode = mode;
+  pool_huge_threshold = threshold;
+}
+
+pool_backing_t pool_backing(const void * ptr){
+  switch(((const pool_header_t *)((const uint8_t *)ptr - POOL_HEADER_SIZE))->info.size_class){
+    case POOL_CLASS_LARGE:   return POOL_BACKING_HEAP;
+    case POOL_CLASS_THP:     return POOL_BACKING_THP;
+    case POOL_CLASS_HUGETLB: return POOL_BACKING_HUGETLB;
+    default:                 return POOL_BACKING_SLAB;
+  }
+}
+
+const char * pool_backing_name(pool_backing_t backing){
+  switch(backing){
+    case POOL_BACKING_HEAP:    return "heap";
+    case POOL_BACKING_THP:     return "thp";
+    case POOL_BACKING_HUGETLB: return "hugetlb";
+    default:                   return "slab";
+  }
+}
+
+void pool_class_stats(size_t size, pool_class_stats_t * out){
+  unsigned int index = pool_class_of(size);
+  pool_block_t * block;
+  size_t depot = 0;
+
+  out->carved = 0;
+  out->depot = 0;
+  out->cached = 0;
+  if(index == POOL_CLASS_LARGE){
+    return;
+  }
+
+  POOL_LOCK();
+  for(block = pool_free_lists[index]; block != NULL; block = block->next){
+    depot++;
+  }
+  out->carved = pool_carved[index];
+  POOL_UNLOCK();
+
+  out->depot = depot;
+  out->cached = pool_cache.count[index];
+}
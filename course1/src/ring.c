@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file ring.c
+ * @brief Lock-free single producer, single consumer byte ring
+ *
+ * The producer only stores head and the consumer only stores tail. Each
+ * side copies its bytes first and then stores its index with release
+ * ordering; the other side loads that index with acquire ordering before
+ * touching the bytes it covers. Nothing blocks and nothing calls into the
+ * C library, so either side may run in a signal handler.
+ *
+ * @author Reeshav Rout
+ * @date 09 October 2025
+ *
+ */
+
+#include "../include/common/ring.h"
+#include "../include/common/memory.h"
+
+/***********************************************************
+                    Private Definitions
+***********************************************************/
+
+#define RING_BACKING_USER  (0)  /* Caller provided buffer */
+#define RING_BACKING_WORDS (1)  /* reserve_aligned() */
+
+/**
+ * @brief Fills in the bookkeeping at the start of a region.
+ *
+ * @param region Pointer to the start of the region, RING_CACHE_LINE aligned.
+ * @param capacity Power of two bytes of storage following the ring_t.
+ * @param backing One of the RING_BACKING values.
+ *
+ * @return Pointer to the ring.
+ */
+static ring_t * ring_setup(uint8_t * region, size_t capacity, uint8_t backing){
+  ring_t * ring = (ring_t *)region;
+
+  ring->data = region + sizeof(ring_t);
+  ring->mask = capacity - 1;
+  ring->backing = backing;
+  ring->head = 0;
+  ring->tail_cache = 0;
+  ring->tail = 0;
+  ring->head_cache = 0;
+  return ring;
+}
+
+/***********************************************************
+                    Function Definitions
+***********************************************************/
+
+ring_t * ring_create(size_t capacity){
+  uint8_t * region;
+  size_t rounded = 1;
+
+  while(rounded < capacity){
+    if(rounded > ((SIZE_MAX - sizeof(ring_t)) >> 1)){
+      return NULL;
+    }
+    rounded <<= 1;
+  }
+  if(rounded > (SIZE_MAX - sizeof(ring_t) - sizeof(int32_t))){
+    return NULL;
+  }
+
+  region = (uint8_t *)reserve_aligned((sizeof(ring_t) + rounded +
+                                       sizeof(int32_t) - 1) / sizeof(int32_t),
+                                      RING_CACHE_LINE);
+  if(region == NULL){
+    return NULL;
+  }
+  return ring_setup(region, rounded, RING_BACKING_WORDS);
+}
+
+ring_t * ring_init(void * buffer, size_t size){
+  uintptr_t start = (uintptr_t)buffer;
+  uintptr_t aligned = (start + RING_CACHE_LINE - 1) &
+                      ~(uintptr_t)(RING_CACHE_LINE - 1);
+  size_t room;
+  size_t capacity = 1;
+
+  if((buffer == NULL) || (size <= ((aligned - start) + sizeof(ring_t)))){
+    return NULL;
+  }
+
+  room = size - (aligned - start) - sizeof(ring_t);
+  while(capacity <= (room >> 1)){
+    capacity <<= 1;
+  }
+  return ring_setup((uint8_t *)aligned, capacity, RING_BACKING_USER);
+}
+
+void ring_destroy(ring_t * ring){
+  if((ring != NULL) && (ring->backing == RING_BACKING_WORDS)){
+    free_aligned((uint32_t *)ring);
+  }
+}
+
+size_t ring_write(ring_t * ring, const uint8_t * src, size_t length){
+  size_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+  size_t capacity = ring->mask + 1;
+  size_t offset = head & ring->mask;
+  size_t first;
+
+  if((capacity - (head - ring->tail_cache)) < length){
+    ring->tail_cache = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if((capacity - (head - ring->tail_cache)) < length){
+      length = capacity - (head - ring->tail_cache);
+    }
+  }
+  if(length == 0){
+    return 0;
+  }
+
+  first = (length < (capacity - offset)) ? length : (capacity - offset);
+  my_memcopy((uint8_t *)src, ring->data + offset, first);
+  if(first < length){
+    my_memcopy((uint8_t *)src + first, ring->data, length - first);
+  }
+
+  __atomic_store_n(&ring->head, head + length, __ATOMIC_RELEASE);
+  return length;
+}
+
+size_t ring_read(ring_t * ring, uint8_t * dst, size_t length){
+  size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+  size_t capacity = ring->mask + 1;
+  size_t offset = tail & ring->mask;
+  size_t first;
+
+  if((ring->head_cache - tail) < length){
+    ring->head_cache = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if((ring->head_cache - tail) < length){
+      length = ring->head_cache - tail;
+    }
+  }
+  if(length == 0){
+    return 0;
+  }
+
+  first = (length < (capacity - offset)) ? length : (capacity - offset);
+  my_memcopy(ring->data + offset, dst, first);
+  if(first < length){
+    my_memcopy(ring->data, dst + first, length - first);
+  }
+
+  __atomic_store_n(&ring->tail, tail + length, __ATOMIC_RELEASE);
+  return length;
+}
+
+int ring_put(ring_t * ring, uint8_t value){
+  size_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+  if((head - ring->tail_cache) > ring->mask){
+    ring->tail_cache = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if((head - ring->tail_cache) > ring->mask){
+      return 0;
+    }
+  }
+
+  ring->data[head & ring->mask] = value;
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+int ring_get(ring_t * ring, uint8_t * value){
+  size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+  if(ring->head_cache == tail){
+    ring->head_cache = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if(ring->head_cache == tail){
+      return 0;
+    }
+  }
+
+  *value = ring->data[tail & ring->mask];
+  __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+size_t ring_used(const ring_t * ring){
+  size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+  size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+  return head - tail;
+}
+
+size_t ring_capacity(const ring_t * ring){
+  return ring->mask + 1;
+}
@@ -28,6 +28,83 @@
  */
 
 #include "../include/common/stats.h"
+#include "../include/common/memory.h"
+
+/* Reductions shared by find_mean(), find_maximum() and find_minimum(). */
+typedef enum {
+  STATS_FOLD_SUM = 0,
+  STATS_FOLD_MAX,
+  STATS_FOLD_MIN
+} stats_fold_t;
+
+/**
+ * @brief Folds a span of an array into a running value.
+ *
+ * @param array Pointer to the first element of the span.
+ * @param count Number of elements in the span.
+ * @param op Reduction to apply.
+ * @param acc Value of the reduction so far.
+ *
+ * @return Sum, maximum or minimum of acc and the elements.
+ */
+static inline unsigned int stats_fold_span(const unsigned char * array,
+                                           unsigned int count,
+                                           stats_fold_t op, unsigned int acc){
+  unsigned int i;
+
+  switch(op){
+    case STATS_FOLD_SUM:
+      for(i = 0; i < count; i++){
+        acc = acc + array[i];
+      }
+      break;
+    case STATS_FOLD_MAX:
+      for(i = 0; i < count; i++){
+        if(array[i] > acc){
+          acc = array[i];
+        }
+      }
+      break;
+    default:
+      for(i = 0; i < count; i++){
+        if(array[i] < acc){
+          acc = array[i];
+        }
+      }
+      break;
+  }
+  return acc;
+}
+
+/**
+ * @brief Folds an array into one value a cache line at a time.
+ *
+ * Arrays of at least MEM_PREFETCH_MIN bytes also prefetch the line the
+ * tuned prefetch distance ahead.
+ *
+ * @param array Pointer to the data.
+ * @param count Number of elements.
+ * @param op Reduction to apply.
+ * @param acc Starting value of the reduction.
+ *
+ * @return Sum, maximum or minimum of acc and the elements.
+ */
+static unsigned int stats_fold(const unsigned char * array, unsigned int count,
+                               stats_fold_t op, unsigned int acc){
+  size_t ahead = (count >= MEM_PREFETCH_MIN) ? my_mem_prefetch_distance() : 0;
+  unsigned int i;
+
+  /* Only the hint depends on the distance, so timings with and without
+     prefetching compare the same loop. */
+  for(i = 0; (count - i) >= MEM_PREFETCH_LINE; i += MEM_PREFETCH_LINE){
+    if((ahead != 0) && ((count - i) > ahead)){
+      MEM_PREFETCH(&array[i + ahead]);
+    }
+    acc = stats_fold_span(&array[i], MEM_PREFETCH_LINE, op, acc);
+  }
+
+  return stats_fold_span(&array[i], count - i, op, acc);
+}
 
 /*
 // Size of the Data Set 
@@ -142,9 +219,7 @@ unsigned char find_mean(unsigned char * array, unsigned int count){
     count = 1;
   }
 
-  for(unsigned int i = 0; i < count; i++){
-    sum = sum + array[i];
-  }
+  sum = stats_fold(array, count, STATS_FOLD_SUM, 0);
  
   return (sum / count);
 
@@ -164,13 +239,7 @@ unsigned char find_maximum(unsigned char * array, unsigned int count){
     return -1;
   }
 
-  max = array[0];
-  
-  for(unsigned int i = 0; i < count; i++){
-    if(array[i] > max){
-      max = array[i];
-    }
-  }
+  max = stats_fold(array, count, STATS_FOLD_MAX, array[0]);
 
   return max;
 
@@ -190,13 +259,7 @@ unsigned char find_minimum(unsigned char * array, unsigned int count){
     return -1;
   }
 
-  min = array[0];
-
-  for(unsigned int i = 0; i < count; i++){
-    if(array[i] < min){
-      min = array[i];
-    }
-  }
+  min = stats_fold(array, count, STATS_FOLD_MIN, array[0]);
 
   return min;
 